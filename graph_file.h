@@ -0,0 +1,198 @@
+#ifndef GRAPH_FILE_H
+#define GRAPH_FILE_H
+
+/*
+ hw06 / hw07 공용 이진 그래프 파일(CSR) 형식. 버전 1.
+
+   [헤더 64바이트]
+     char     magic[8]   "DSHWGRF"
+     uint32_t version    1
+     uint32_t flags      GF_WEIGHTED: 가중치 배열 포함
+     uint64_t n          정점 수
+     uint64_t m          방향 간선 수(무방향 간선당 2)
+     uint64_t off_pos    오프셋 배열 위치(바이트)
+     uint64_t adj_pos    이웃 배열 위치
+     uint64_t w_pos      가중치 배열 위치(없으면 0)
+     uint64_t reserved
+   [uint64_t off[n + 1]]   정점 u의 이웃은 adj[off[u] .. off[u+1])
+   [int32_t  adj[m]]       정점별 오름차순
+   [int32_t  w[m]]         (선택) adj와 같은 순서의 가중치
+
+ 모든 배열은 8바이트 경계에 놓이므로 mmap한 주소를 그대로 배열로 쓸 수 있다(제로 카피).
+ 바이트 순서는 쓰는 기계의 것을 따른다(리틀 엔디언 가정).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define GF_MAGIC    "DSHWGRF"
+#define GF_VERSION  1u
+#define GF_WEIGHTED 1u
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t n;
+    uint64_t m;
+    uint64_t off_pos;
+    uint64_t adj_pos;
+    uint64_t w_pos;
+    uint64_t reserved;
+} GraphFileHeader;
+
+// 읽기 전용으로 매핑된 그래프. 포인터들은 매핑 영역을 직접 가리킨다.
+typedef struct {
+    uint64_t n;
+    uint64_t m;
+    const uint64_t* off;
+    const int32_t* adj;
+    const int32_t* w;       // 가중치 없으면 NULL
+    void* base;
+    size_t len;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+} GraphFile;
+
+static inline uint64_t gf_align8(uint64_t x) { return (x + 7) & ~(uint64_t)7; }
+
+// [pos, pos + count * elem)가 길이 len 안에 들어가는지(곱셈/덧셈 넘침 포함 검사)
+static inline bool gf_range_ok(uint64_t pos, uint64_t count, uint64_t elem, uint64_t len) {
+    if (pos > len || count > (len - pos) / elem) return false;
+    return true;
+}
+
+// CSR 배열을 파일로 저장. w == NULL이면 비가중 그래프. 성공 시 true.
+static inline bool gf_write(const char* path, uint64_t n, const uint64_t* off, const int32_t* adj, const int32_t* w) {
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        perror("graph file open");
+        return false;
+    }
+    GraphFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, GF_MAGIC, sizeof(GF_MAGIC));
+    h.version = GF_VERSION;
+    h.flags = w ? GF_WEIGHTED : 0u;
+    h.n = n;
+    h.m = off[n];
+    h.off_pos = sizeof(GraphFileHeader);
+    h.adj_pos = h.off_pos + (n + 1) * sizeof(uint64_t);
+    h.w_pos = w ? gf_align8(h.adj_pos + h.m * sizeof(int32_t)) : 0;
+
+    static const char pad[8] = { 0 };
+    size_t padLen = w ? (size_t)(h.w_pos - (h.adj_pos + h.m * sizeof(int32_t))) : 0;
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1
+           && fwrite(off, sizeof(uint64_t), (size_t)n + 1, fp) == (size_t)n + 1
+           && fwrite(adj, sizeof(int32_t), (size_t)h.m, fp) == (size_t)h.m;
+    if (ok && w) {
+        ok = fwrite(pad, 1, padLen, fp) == padLen
+          && fwrite(w, sizeof(int32_t), (size_t)h.m, fp) == (size_t)h.m;
+    }
+    if (fclose(fp) != 0) ok = false;
+    if (!ok) fprintf(stderr, "[ERR] 그래프 파일 쓰기 실패: %s\n", path);
+    return ok;
+}
+
+static inline void gf_close(GraphFile* gf) {
+    if (!gf->base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(gf->base);
+    CloseHandle(gf->mapping);
+    CloseHandle(gf->file);
+#else
+    munmap(gf->base, gf->len);
+#endif
+    gf->base = NULL;
+}
+
+// 파일을 읽기 전용으로 매핑하고 헤더와 오프셋 배열을 검증한다(이웃 번호는 호출 측에서). 성공 시 true.
+static inline bool gf_open(const char* path, GraphFile* gf) {
+    memset(gf, 0, sizeof(*gf));
+#ifdef _WIN32
+    gf->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (gf->file == INVALID_HANDLE_VALUE) {
+        fprintf(stderr, "[ERR] 그래프 파일 열기 실패: %s\n", path);
+        return false;
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(gf->file, &size);
+    gf->len = (size_t)size.QuadPart;
+    gf->mapping = CreateFileMappingA(gf->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    gf->base = gf->mapping ? MapViewOfFile(gf->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!gf->base) {
+        fprintf(stderr, "[ERR] 그래프 파일 매핑 실패: %s\n", path);
+        if (gf->mapping) CloseHandle(gf->mapping);
+        CloseHandle(gf->file);
+        return false;
+    }
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror("graph file open");
+        return false;
+    }
+    struct stat stt;
+    if (fstat(fd, &stt) != 0) {
+        perror("graph file stat");
+        close(fd);
+        return false;
+    }
+    gf->len = (size_t)stt.st_size;
+    void* p = gf->len ? mmap(NULL, gf->len, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (p == MAP_FAILED) {
+        perror("graph file mmap");
+        return false;
+    }
+    gf->base = p;
+#endif
+
+    const GraphFileHeader* h = (const GraphFileHeader*)gf->base;
+    const char* err = NULL;
+    if (gf->len < sizeof(GraphFileHeader) || memcmp(h->magic, GF_MAGIC, sizeof(GF_MAGIC)) != 0)
+        err = "형식이 아님";
+    else if (h->version != GF_VERSION)
+        err = "지원하지 않는 버전";
+    else if ((h->off_pos | h->adj_pos | h->w_pos) & 7)
+        err = "배열 위치가 8바이트 정렬이 아님";
+    else if (!gf_range_ok(h->off_pos, h->n + 1, sizeof(uint64_t), gf->len) || h->n == UINT64_MAX
+          || !gf_range_ok(h->adj_pos, h->m, sizeof(int32_t), gf->len)
+          || ((h->flags & GF_WEIGHTED) && !gf_range_ok(h->w_pos, h->m, sizeof(int32_t), gf->len)))
+        err = "파일 길이 부족";
+    else {
+        // 오프셋 배열 한 번 훑기(O(n)): off[0] == 0, 감소 없음, off[n] == m
+        const uint64_t* off = (const uint64_t*)((const char*)gf->base + h->off_pos);
+        if (off[0] != 0 || off[h->n] != h->m) err = "오프셋 배열 범위 오류";
+        for (uint64_t u = 0; !err && u < h->n; ++u)
+            if (off[u + 1] < off[u]) err = "오프셋 배열이 감소함";
+    }
+    if (err) {
+        fprintf(stderr, "[ERR] 그래프 파일 %s: %s\n", path, err);
+        gf_close(gf);
+        return false;
+    }
+    const char* b = (const char*)gf->base;
+    gf->n = h->n;
+    gf->m = h->m;
+    gf->off = (const uint64_t*)(b + h->off_pos);
+    gf->adj = (const int32_t*)(b + h->adj_pos);
+    gf->w = (h->flags & GF_WEIGHTED) ? (const int32_t*)(b + h->w_pos) : NULL;
+    return true;
+}
+
+#endif
@@ -2,6 +2,25 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <time.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef _WIN32
+#include <windows.h>    // SwitchToThread
+#else
+#include <sched.h>      // sched_yield
+#endif
+#include "graph_file.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// 빌드 예: gcc -O2 -fopenmp -mavx2 hw06.c -o hw06 -lm
+// (-fopenmp / -mavx2 없이도 단일 스레드·스칼라 경로로 동작)
 
 // 설정
 #define N_VERT 100
@@ -21,6 +40,51 @@ static inline void resetCounters(Counters* c) {
     c->cmp_neighbors = 0;
 }
 
+// 스레드/시간 유틸 (OpenMP 미사용 빌드에서는 단일 스레드)
+static inline int thread_count(void) {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+static inline int thread_id(void) {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+static inline double now_sec(void) {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+// 스핀락(짧은 임계 구역용). 오래 돌면 CPU를 양보해 과다 구독 시에도 진행되게 한다.
+static inline void cpu_yield(void) {
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+static inline void spin_lock(int* l) {
+    while (__atomic_test_and_set(l, __ATOMIC_ACQUIRE)) {
+        int spins = 0;
+        while (__atomic_load_n(l, __ATOMIC_RELAXED)) {
+            if (++spins == 1024) { cpu_yield(); spins = 0; }
+        }
+    }
+}
+
+static inline void spin_unlock(int* l) { __atomic_clear(l, __ATOMIC_RELEASE); }
+
 // ========================= 인접행렬 그래프 =========================
 typedef struct {
     int n;              // 정점 수
@@ -86,7 +150,313 @@ size_t am_memory_bytes(AdjMatrix* g) {
     return sizeof(AdjMatrix) + (size_t)g->n * (size_t)g->n * sizeof(unsigned char);
 }
 
+// ========================= 비트 인접행렬 그래프 =========================
+// 정점 쌍당 1비트. 각 행은 64비트 워드 단위로 패딩해 워드 병렬 연산이 가능하다.
+// (unsigned char 행렬 대비 메모리 1/8, 10만 정점 밀집 그래프도 약 1.25GB)
+typedef struct {
+    int n;              // 정점 수
+    int words;          // 행당 64비트 워드 수 = ceil(n / 64)
+    uint64_t* bits;     // n x words
+} BitMatrix;
+
+static inline uint64_t* bm_row(const BitMatrix* g, int u) {
+    return g->bits + (size_t)u * (size_t)g->words;
+}
+
+static inline int popcount64(uint64_t x) { return __builtin_popcountll(x); }
+static inline int ctz64(uint64_t x) { return __builtin_ctzll(x); }
+
+BitMatrix* bm_create(int n) {
+    BitMatrix* g = (BitMatrix*)malloc(sizeof(BitMatrix));
+    g->n = n;
+    g->words = (n + 63) / 64;
+    g->bits = (uint64_t*)calloc((size_t)n * (size_t)g->words, sizeof(uint64_t));
+    return g;
+}
+
+void bm_free(BitMatrix* g) {
+    if (!g) return;
+    free(g->bits);
+    free(g);
+}
+
+// 비교 정의는 인접행렬과 동일(비트 읽기 후 비교 1회)
+bool bm_has_edge(BitMatrix* g, int u, int v, Counters* c) {
+    c->cmp_connected += 1;
+    return (bm_row(g, u)[v >> 6] >> (v & 63)) & 1u;
+}
+
+bool bm_insert_edge(BitMatrix* g, int u, int v, Counters* c) {
+    c->cmp_insert_delete += 1;
+    uint64_t* ru = bm_row(g, u);
+    if ((ru[v >> 6] >> (v & 63)) & 1u) return false;
+    ru[v >> 6] |= 1ull << (v & 63);
+    bm_row(g, v)[u >> 6] |= 1ull << (u & 63);
+    return true;
+}
+
+bool bm_delete_edge(BitMatrix* g, int u, int v, Counters* c) {
+    c->cmp_insert_delete += 1;
+    uint64_t* ru = bm_row(g, u);
+    if (!((ru[v >> 6] >> (v & 63)) & 1u)) return false;
+    ru[v >> 6] &= ~(1ull << (v & 63));
+    bm_row(g, v)[u >> 6] &= ~(1ull << (u & 63));
+    return true;
+}
+
+// 인접 노드 나열: 워드 단위(64열)로 0 여부를 비교 1회로 보고,
+// 0이 아닌 워드는 ctz로 켜진 비트만 꺼낸다.
+int bm_neighbors(BitMatrix* g, int u, int* out, int cap, Counters* c) {
+    const uint64_t* r = bm_row(g, u);
+    int count = 0;
+    for (int w = 0; w < g->words; ++w) {
+        c->cmp_neighbors += 1;
+        uint64_t x = r[w];
+        while (x) {
+            int v = (w << 6) + ctz64(x);
+            if (count < cap) out[count] = v;
+            count++;
+            x &= x - 1;
+        }
+    }
+    return count;
+}
+
+int bm_degree(const BitMatrix* g, int u) {
+    const uint64_t* r = bm_row(g, u);
+    int d = 0;
+    for (int w = 0; w < g->words; ++w) d += popcount64(r[w]);
+    return d;
+}
+
+#ifdef __AVX2__
+// AVX2 바이트 단위 popcount(니블 룩업) 후 64비트 lane 합산
+static inline __m256i popcount256(__m256i x) {
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(x, low);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), low);
+    __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lut, lo), _mm256_shuffle_epi8(lut, hi));
+    return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+#endif
+
+// 두 행의 [from, to) 워드 구간에 대해 popcount(a & b)
+static int bm_and_popcount(const uint64_t* a, const uint64_t* b, int from, int to) {
+    int w = from;
+    long long total = 0;
+#ifdef __AVX2__
+    __m256i acc = _mm256_setzero_si256();
+    for (; w + 4 <= to; w += 4) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(a + w));
+        __m256i y = _mm256_loadu_si256((const __m256i*)(b + w));
+        acc = _mm256_add_epi64(acc, popcount256(_mm256_and_si256(x, y)));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    total = (long long)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+#endif
+    for (; w < to; ++w) total += popcount64(a[w] & b[w]);
+    return (int)total;
+}
+
+// u, v의 공통 이웃 수: 행 AND + popcount
+int bm_common_neighbors(const BitMatrix* g, int u, int v) {
+    return bm_and_popcount(bm_row(g, u), bm_row(g, v), 0, g->words);
+}
+
+size_t bm_memory_bytes(BitMatrix* g) {
+    // 구조체 + 비트 행렬
+    return sizeof(BitMatrix) + (size_t)g->n * (size_t)g->words * sizeof(uint64_t);
+}
+
 // ========================= 인접리스트 그래프 =========================
+// AL_UNROLLED=1(기본): 64바이트 청크에 이웃 14개씩 담는 펼친(unrolled) 리스트 + 그래프별 청크 풀
+// AL_UNROLLED=0      : 간선마다 노드 하나를 malloc하는 원래 연결 리스트
+#ifndef AL_UNROLLED
+#define AL_UNROLLED 1
+#endif
+
+#if AL_UNROLLED
+
+#define AL_CHUNK_IDS   14     // 14 * 4 + 8(next) = 64바이트 = 캐시 라인 1개
+#define AL_POOL_BLOCK  64     // 풀 블록당 청크 수(4KB)
+
+typedef struct AlChunk {
+    int v[AL_CHUNK_IDS];
+    struct AlChunk* next;
+} AlChunk;
+
+// 청크 풀: 4KB 블록 단위로 확보하고, 반납된 청크는 free list로 재사용.
+// 병렬 빌더/동시 삽입에서 함께 쓰므로 스핀락으로 보호한다.
+typedef struct {
+    void** blocks;      // 블록 원시 포인터(해제용)
+    int nblocks, capBlocks;
+    AlChunk* freeList;
+    AlChunk* bump;      // 현재 블록에서 아직 안 쓴 청크
+    int bumpLeft;
+    size_t reserved;    // 확보한 청크 수
+    int lock;
+} AlPool;
+
+typedef struct {
+    int n;
+    AlChunk** heads;    // 크기 n. 머리 청크만 덜 찰 수 있다
+    int* deg;           // 크기 n. 정점별 이웃 수
+    AlPool pool;
+} AdjList;
+
+static AlChunk* al_chunk_alloc(AlPool* p) {
+    spin_lock(&p->lock);
+    AlChunk* ch = p->freeList;
+    if (ch) {
+        p->freeList = ch->next;
+    } else {
+        if (p->bumpLeft == 0) {
+            if (p->nblocks == p->capBlocks) {
+                p->capBlocks = p->capBlocks ? p->capBlocks * 2 : 16;
+                p->blocks = (void**)realloc(p->blocks, (size_t)p->capBlocks * sizeof(void*));
+                if (!p->blocks) { perror("realloc"); exit(1); }
+            }
+            // 청크가 캐시 라인 경계에 오도록 64바이트 정렬
+            void* raw = malloc(AL_POOL_BLOCK * sizeof(AlChunk) + 63);
+            if (!raw) { perror("malloc"); exit(1); }
+            p->blocks[p->nblocks++] = raw;
+            p->bump = (AlChunk*)(((uintptr_t)raw + 63) & ~(uintptr_t)63);
+            p->bumpLeft = AL_POOL_BLOCK;
+            p->reserved += AL_POOL_BLOCK;
+        }
+        ch = p->bump++;
+        p->bumpLeft--;
+    }
+    spin_unlock(&p->lock);
+    return ch;
+}
+
+static void al_chunk_release(AlPool* p, AlChunk* ch) {
+    spin_lock(&p->lock);
+    ch->next = p->freeList;
+    p->freeList = ch;
+    spin_unlock(&p->lock);
+}
+
+// 차수 d일 때 머리 청크에 든 이웃 수
+static inline int al_head_fill(int d) { return d == 0 ? 0 : (d - 1) % AL_CHUNK_IDS + 1; }
+
+AdjList* al_create(int n) {
+    AdjList* g = (AdjList*)calloc(1, sizeof(AdjList));
+    g->n = n;
+    g->heads = (AlChunk**)calloc(n, sizeof(AlChunk*));
+    g->deg = (int*)calloc(n, sizeof(int));
+    return g;
+}
+
+void al_free(AdjList* g) {
+    if (!g) return;
+    for (int i = 0; i < g->pool.nblocks; ++i) free(g->pool.blocks[i]);
+    free(g->pool.blocks);
+    free(g->heads);
+    free(g->deg);
+    free(g);
+}
+
+// 비교 정의는 노드 리스트와 동일: 살펴본 이웃 1개당 1회
+bool al_has_edge(AdjList* g, int u, int v, Counters* c) {
+    int k = al_head_fill(g->deg[u]);
+    for (AlChunk* ch = g->heads[u]; ch; ch = ch->next, k = AL_CHUNK_IDS) {
+        for (int i = 0; i < k; ++i) {
+            c->cmp_connected += 1;
+            if (ch->v[i] == v) return true;
+        }
+    }
+    return false;
+}
+
+// 내부: 중복 확인 없이 u 리스트에 v 추가(비교 없음)
+static void al_push_unchecked(AdjList* g, int u, int v) {
+    int k = al_head_fill(g->deg[u]);
+    if (k == 0 || k == AL_CHUNK_IDS) {
+        AlChunk* ch = al_chunk_alloc(&g->pool);
+        ch->next = g->heads[u];
+        g->heads[u] = ch;
+        k = 0;
+    }
+    g->heads[u]->v[k] = v;
+    g->deg[u]++;
+}
+
+// 내부: u 리스트에 v가 있는지(삽입/삭제 비교로 기록)
+static bool al_contains_for_update(AdjList* g, int u, int v, Counters* c) {
+    int k = al_head_fill(g->deg[u]);
+    for (AlChunk* ch = g->heads[u]; ch; ch = ch->next, k = AL_CHUNK_IDS) {
+        for (int i = 0; i < k; ++i) {
+            c->cmp_insert_delete += 1;
+            if (ch->v[i] == v) return true;
+        }
+    }
+    return false;
+}
+
+// 내부: u의 리스트에서 v 삭제. 빈자리는 머리 청크의 마지막 원소로 채우고,
+// 머리 청크가 비면 풀에 반납한다.
+static bool al_delete_from_list(AdjList* g, int u, int v, Counters* c) {
+    int k = al_head_fill(g->deg[u]);
+    for (AlChunk* ch = g->heads[u]; ch; ch = ch->next, k = AL_CHUNK_IDS) {
+        for (int i = 0; i < k; ++i) {
+            c->cmp_insert_delete += 1;
+            if (ch->v[i] == v) {
+                AlChunk* h = g->heads[u];
+                int last = al_head_fill(g->deg[u]) - 1;
+                ch->v[i] = h->v[last];
+                g->deg[u]--;
+                if (last == 0) {
+                    g->heads[u] = h->next;
+                    al_chunk_release(&g->pool, h);
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool al_insert_edge(AdjList* g, int u, int v, Counters* c) {
+    // 중복 방지: 존재 여부 확인(최대 차수만큼 비교 발생)
+    if (al_contains_for_update(g, u, v, c)) return false;
+    al_push_unchecked(g, u, v);
+    // v 측에도 삽입(반대쪽이 이미 있으면 생략)
+    if (!al_contains_for_update(g, v, u, c)) al_push_unchecked(g, v, u);
+    return true;
+}
+
+bool al_delete_edge(AdjList* g, int u, int v, Counters* c) {
+    bool a = al_delete_from_list(g, u, v, c);
+    bool b = al_delete_from_list(g, v, u, c);
+    return a && b;
+}
+
+int al_neighbors(AdjList* g, int u, int* out, int cap, Counters* c) {
+    int count = 0;
+    int k = al_head_fill(g->deg[u]);
+    for (AlChunk* ch = g->heads[u]; ch; ch = ch->next, k = AL_CHUNK_IDS) {
+        // 방문 1회를 비교 1회로 간주(노드 리스트와 동일)
+        c->cmp_neighbors += k;
+        for (int i = 0; i < k; ++i) {
+            if (count < cap) out[count] = ch->v[i];
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t al_memory_bytes(AdjList* g) {
+    // 구조체 + 머리 포인터/차수 배열 + 풀이 확보한 청크 전체
+    return sizeof(AdjList) + (size_t)g->n * (sizeof(AlChunk*) + sizeof(int))
+         + g->pool.reserved * sizeof(AlChunk) + (size_t)g->pool.capBlocks * sizeof(void*);
+}
+
+#else
 typedef struct Node {
     int v;
     struct Node* next;
@@ -208,6 +578,138 @@ size_t al_memory_bytes(AdjList* g) {
     return bytes;
 }
 
+// 내부: 중복 확인 없이 u 리스트 앞에 v 추가(빌더 전용, 비교 없음)
+static void al_push_unchecked(AdjList* g, int u, int v) {
+    Node* a = (Node*)malloc(sizeof(Node));
+    if (!a) { perror("malloc"); exit(1); }
+    a->v = v; a->next = g->heads[u]; g->heads[u] = a;
+}
+
+#endif
+
+// ========================= 동시 쓰기 인접리스트 =========================
+// 정점을 줄무늬(stripe) 락에 대응시키고, 간선 (u, v) 갱신은 두 줄무늬를 번호 순서대로 잡아
+// 교착 없이 양 끝 리스트를 함께 바꾼다. 읽기는 u의 줄무늬를 잡으므로 항상 일관된 리스트를 본다.
+// 청크 풀은 자체 스핀락으로 보호된다(AL_UNROLLED=0이면 malloc이 스레드 안전).
+
+typedef struct {
+    int lock;
+    char pad[60];       // 락마다 캐시 라인 하나(거짓 공유 방지)
+} PaddedLock;
+
+typedef struct {
+    AdjList* g;
+    int mask;           // 줄무늬 수 - 1 (2의 거듭제곱)
+    PaddedLock* locks;
+} ConcAdjList;
+
+ConcAdjList* cal_create(int n, int stripes) {
+    int s = 1;
+    while (s < stripes) s <<= 1;
+    ConcAdjList* cg = (ConcAdjList*)malloc(sizeof(ConcAdjList));
+    cg->g = al_create(n);
+    cg->mask = s - 1;
+    cg->locks = (PaddedLock*)calloc((size_t)s, sizeof(PaddedLock));
+    if (!cg->locks) { perror("calloc"); exit(1); }
+    return cg;
+}
+
+void cal_free(ConcAdjList* cg) {
+    if (!cg) return;
+    al_free(cg->g);
+    free(cg->locks);
+    free(cg);
+}
+
+static inline void cal_lock_pair(ConcAdjList* cg, int u, int v) {
+    int a = u & cg->mask, b = v & cg->mask;
+    if (a > b) { int t = a; a = b; b = t; }
+    spin_lock(&cg->locks[a].lock);
+    if (b != a) spin_lock(&cg->locks[b].lock);
+}
+
+static inline void cal_unlock_pair(ConcAdjList* cg, int u, int v) {
+    int a = u & cg->mask, b = v & cg->mask;
+    if (b != a) spin_unlock(&cg->locks[b].lock);
+    spin_unlock(&cg->locks[a].lock);
+}
+
+bool cal_insert_edge(ConcAdjList* cg, int u, int v, Counters* c) {
+    cal_lock_pair(cg, u, v);
+    bool ok = al_insert_edge(cg->g, u, v, c);
+    cal_unlock_pair(cg, u, v);
+    return ok;
+}
+
+bool cal_delete_edge(ConcAdjList* cg, int u, int v, Counters* c) {
+    cal_lock_pair(cg, u, v);
+    bool ok = al_delete_edge(cg->g, u, v, c);
+    cal_unlock_pair(cg, u, v);
+    return ok;
+}
+
+bool cal_has_edge(ConcAdjList* cg, int u, int v, Counters* c) {
+    int* l = &cg->locks[u & cg->mask].lock;
+    spin_lock(l);
+    bool ok = al_has_edge(cg->g, u, v, c);
+    spin_unlock(l);
+    return ok;
+}
+
+// 잠근 상태에서 이웃을 복사하므로 out은 한 시점의 리스트 스냅숏이다
+int cal_neighbors(ConcAdjList* cg, int u, int* out, int cap, Counters* c) {
+    int* l = &cg->locks[u & cg->mask].lock;
+    spin_lock(l);
+    int d = al_neighbors(cg->g, u, out, cap, c);
+    spin_unlock(l);
+    return d;
+}
+
+// ========================= CSR(압축 희소 행) 그래프 =========================
+// 정적 그래프용 압축 표현. 정점 u의 이웃은 adj[off[u] .. off[u+1]) 에 오름차순으로 놓인다.
+typedef struct {
+    int n;              // 정점 수
+    size_t m;           // 방향 간선 수(무방향 간선당 2)
+    uint64_t* off;      // 크기 n + 1
+    int* adj;           // 크기 m
+} CsrGraph;
+
+static inline int csr_degree(const CsrGraph* g, int u) {
+    return (int)(g->off[u + 1] - g->off[u]);
+}
+
+void csr_free(CsrGraph* g) {
+    if (!g) return;
+    free(g->off);
+    free(g->adj);
+    free(g);
+}
+
+// 정렬된 이웃에서 이분 탐색(비교 1회 = 탐색 단계 1회)
+bool csr_has_edge(CsrGraph* g, int u, int v, Counters* c) {
+    uint64_t lo = g->off[u], hi = g->off[u + 1];
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        c->cmp_connected += 1;
+        if (g->adj[mid] < v) lo = mid + 1; else hi = mid;
+    }
+    return lo < g->off[u + 1] && g->adj[lo] == v;
+}
+
+int csr_neighbors(CsrGraph* g, int u, int* out, int cap, Counters* c) {
+    int count = 0;
+    for (uint64_t i = g->off[u]; i < g->off[u + 1]; ++i) {
+        c->cmp_neighbors += 1; // 방문 1회를 비교 1회로 간주(인접리스트와 동일)
+        if (count < cap) out[count] = g->adj[i];
+        count++;
+    }
+    return count;
+}
+
+size_t csr_memory_bytes(CsrGraph* g) {
+    return sizeof(CsrGraph) + ((size_t)g->n + 1) * sizeof(uint64_t) + g->m * sizeof(int);
+}
+
 // ========================= 랜덤 그래프 생성(무방향, 단일 간선, 무루프) =========================
 
 typedef struct {
@@ -239,6 +741,182 @@ void generate_random_edges(int n, int targetEdges, Edge* edges_out, int* outCoun
     *outCount = cnt;
 }
 
+// ========================= 대규모 랜덤 그래프 생성(O(m) 메모리) =========================
+// n x n 사용 여부 배열 없이 간선을 스트림으로 만든다.
+// 난수 스트림은 (seed, 블록 번호)로 시드하므로 스레드 수와 무관하게 같은 그래프가 나온다.
+
+typedef struct {
+    Edge* e;
+    size_t m, cap;
+} EdgeList;
+
+static void el_push(EdgeList* L, int u, int v) {
+    if (L->m == L->cap) {
+        L->cap = L->cap ? L->cap * 2 : 1024;
+        L->e = (Edge*)realloc(L->e, L->cap * sizeof(Edge));
+        if (!L->e) { perror("realloc"); exit(1); }
+    }
+    L->e[L->m].u = u;
+    L->e[L->m].v = v;
+    L->m++;
+}
+
+void el_free(EdgeList* L) {
+    free(L->e);
+    L->e = NULL;
+    L->m = L->cap = 0;
+}
+
+// 블록별 리스트를 블록 순서대로 이어 붙인다(결정적 출력)
+static EdgeList el_concat(EdgeList* parts, int count) {
+    size_t* start = (size_t*)malloc(((size_t)count + 1) * sizeof(size_t));
+    start[0] = 0;
+    for (int i = 0; i < count; ++i) start[i + 1] = start[i] + parts[i].m;
+    EdgeList out = { NULL, start[count], start[count] };
+    out.e = (Edge*)malloc((out.m ? out.m : 1) * sizeof(Edge));
+    if (!out.e) { perror("malloc"); exit(1); }
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int i = 0; i < count; ++i) {
+        if (parts[i].m) memcpy(out.e + start[i], parts[i].e, parts[i].m * sizeof(Edge));
+        el_free(&parts[i]);
+    }
+    free(start);
+    return out;
+}
+
+// 스트림별 RNG: splitmix64로 시드 후 xorshift64*
+typedef struct { uint64_t s; } Rng;
+
+static inline uint64_t splitmix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static inline void rng_seed(Rng* r, uint64_t seed, uint64_t stream) {
+    r->s = splitmix64(seed ^ splitmix64(stream + 1));
+    if (r->s == 0) r->s = 1;
+}
+
+static inline uint64_t rng_next(Rng* r) {
+    uint64_t x = r->s;
+    x ^= x >> 12; x ^= x << 25; x ^= x >> 27;
+    r->s = x;
+    return x * 0x2545F4914F6CDD1Dull;
+}
+
+// (0, 1] 균등 실수
+static inline double rng_unit(Rng* r) {
+    return ((rng_next(r) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+#define GEN_ROW_BLOCK   1024     // ER: 스트림 하나가 담당하는 행 수
+#define GEN_EDGE_BLOCK  65536    // R-MAT/멱법칙: 스트림 하나가 만드는 간선 수
+
+// Erdős–Rényi G(n, p), p = targetEdges / (n(n-1)/2).
+// 각 행 u의 후보 (u, v>u)를 기하분포 건너뛰기로 훑으므로 기대 O(n + m) 시간.
+EdgeList gen_erdos_renyi(int n, size_t targetEdges, uint64_t seed) {
+    double pairs = (double)n * (double)(n - 1) / 2.0;
+    double p = pairs > 0 ? (double)targetEdges / pairs : 0.0;
+    if (p > 1.0) p = 1.0;
+    int blocks = (n + GEN_ROW_BLOCK - 1) / GEN_ROW_BLOCK;
+    EdgeList* parts = (EdgeList*)calloc((size_t)blocks, sizeof(EdgeList));
+    double logq = log(1.0 - p);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int b = 0; b < blocks; ++b) {
+        if (p <= 0.0) continue;
+        Rng r; rng_seed(&r, seed, (uint64_t)b);
+        int uEnd = (b + 1) * GEN_ROW_BLOCK < n ? (b + 1) * GEN_ROW_BLOCK : n;
+        for (int u = b * GEN_ROW_BLOCK; u < uEnd; ++u) {
+            long long v = u;
+            for (;;) {
+                // 다음 성공까지 건너뛸 후보 수 ~ Geometric(p)
+                double skip = p >= 1.0 ? 0.0 : floor(log(rng_unit(&r)) / logq);
+                if ((double)v + 1.0 + skip >= (double)n) break;
+                v += 1 + (long long)skip;
+                el_push(&parts[b], u, (int)v);
+            }
+        }
+    }
+    EdgeList out = el_concat(parts, blocks);
+    free(parts);
+    return out;
+}
+
+// R-MAT(Kronecker) 생성기: 사분면 확률 (a, b, c, 1-a-b-c)로 비트를 하나씩 결정.
+// 자기 루프와 범위 밖 정점은 다시 뽑고, 중복 간선은 그대로 둔다(빌더에서 제거).
+EdgeList gen_rmat(int n, size_t m, double a, double b, double c, uint64_t seed) {
+    int scale = 0;
+    while ((1ll << scale) < n) scale++;
+    EdgeList out = { (Edge*)malloc((m ? m : 1) * sizeof(Edge)), m, m };
+    if (!out.e) { perror("malloc"); exit(1); }
+    long long blocks = (long long)((m + GEN_EDGE_BLOCK - 1) / GEN_EDGE_BLOCK);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long blk = 0; blk < blocks; ++blk) {
+        Rng r; rng_seed(&r, seed, (uint64_t)blk);
+        size_t end = (size_t)(blk + 1) * GEN_EDGE_BLOCK < m ? (size_t)(blk + 1) * GEN_EDGE_BLOCK : m;
+        for (size_t i = (size_t)blk * GEN_EDGE_BLOCK; i < end; ++i) {
+            int u, v;
+            do {
+                u = 0; v = 0;
+                for (int k = 0; k < scale; ++k) {
+                    double x = rng_unit(&r);
+                    int bu = x > a + b;                       // c, d 사분면
+                    int bv = (x > a && x <= a + b) || x > a + b + c; // b, d 사분면
+                    u = (u << 1) | bu;
+                    v = (v << 1) | bv;
+                }
+            } while (u >= n || v >= n || u == v);
+            if (u > v) { int t = u; u = v; v = t; }
+            out.e[i].u = u;
+            out.e[i].v = v;
+        }
+    }
+    return out;
+}
+
+// 멱법칙 차수 모델(Chung–Lu): 정점 i의 기대 차수 ∝ (i+1)^(-1/(gamma-1)).
+// 양 끝점을 누적 가중치에서 이분 탐색으로 독립 추출. 중복은 빌더에서 제거.
+EdgeList gen_power_law(int n, size_t m, double gamma, uint64_t seed) {
+    double* cdf = (double*)malloc((size_t)n * sizeof(double));
+    if (!cdf) { perror("malloc"); exit(1); }
+    double expo = -1.0 / (gamma - 1.0), acc = 0.0;
+    for (int i = 0; i < n; ++i) {
+        acc += pow((double)(i + 1), expo);
+        cdf[i] = acc;
+    }
+    EdgeList out = { (Edge*)malloc((m ? m : 1) * sizeof(Edge)), m, m };
+    if (!out.e) { perror("malloc"); exit(1); }
+    long long blocks = (long long)((m + GEN_EDGE_BLOCK - 1) / GEN_EDGE_BLOCK);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long long blk = 0; blk < blocks; ++blk) {
+        Rng r; rng_seed(&r, seed, (uint64_t)blk);
+        size_t end = (size_t)(blk + 1) * GEN_EDGE_BLOCK < m ? (size_t)(blk + 1) * GEN_EDGE_BLOCK : m;
+        for (size_t i = (size_t)blk * GEN_EDGE_BLOCK; i < end; ++i) {
+            int ends[2];
+            do {
+                for (int k = 0; k < 2; ++k) {
+                    double x = rng_unit(&r) * acc;
+                    int lo = 0, hi = n - 1;
+                    while (lo < hi) {
+                        int mid = lo + (hi - lo) / 2;
+                        if (cdf[mid] < x) lo = mid + 1; else hi = mid;
+                    }
+                    ends[k] = lo;
+                }
+            } while (ends[0] == ends[1]);
+            out.e[i].u = ends[0] < ends[1] ? ends[0] : ends[1];
+            out.e[i].v = ends[0] < ends[1] ? ends[1] : ends[0];
+        }
+    }
+    free(cdf);
+    return out;
+}
+
 // 빌드 함수들
 AdjMatrix* build_am_from_edges(int n, Edge* E, int m, Counters* c) {
     AdjMatrix* g = am_create(n);
@@ -248,6 +926,14 @@ AdjMatrix* build_am_from_edges(int n, Edge* E, int m, Counters* c) {
     return g;
 }
 
+BitMatrix* build_bm_from_edges(int n, Edge* E, int m, Counters* c) {
+    BitMatrix* g = bm_create(n);
+    for (int i = 0; i < m; ++i) {
+        bm_insert_edge(g, E[i].u, E[i].v, c);
+    }
+    return g;
+}
+
 AdjList* build_al_from_edges(int n, Edge* E, int m, Counters* c) {
     AdjList* g = al_create(n);
     for (int i = 0; i < m; ++i) {
@@ -256,41 +942,1125 @@ AdjList* build_al_from_edges(int n, Edge* E, int m, Counters* c) {
     return g;
 }
 
-// ========================= 벤치마크 루틴 =========================
+// ========================= 병렬 CSR 빌더 =========================
+// 1) 원자적 차수 집계  2) 누적합으로 오프셋  3) 원자적 커서로 출발 정점별 분할 배치
+// 4) 정점별 정렬 + 중복 제거(스레드마다 독립)  5) 압축. 모두 선형 패스.
 
-typedef struct {
-    const char* name;
-    size_t memBytes;
-    long long cmp_ins_del;
-    long long cmp_conn;
-    long long cmp_nei;
-} Report;
+static int cmp_int_asc(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
 
-void benchmark_am(const char* name, int n, Edge* baseEdges, int m, Report* rep) {
-    Counters c; resetCounters(&c);
-    AdjMatrix* g = build_am_from_edges(n, baseEdges, m, &c);
+static void sort_ints(int* a, size_t n) {
+    if (n <= 32) {
+        for (size_t i = 1; i < n; ++i) {
+            int key = a[i];
+            size_t j = i;
+            while (j > 0 && a[j - 1] > key) { a[j] = a[j - 1]; j--; }
+            a[j] = key;
+        }
+    } else {
+        qsort(a, n, sizeof(int), cmp_int_asc);
+    }
+}
 
-    // 메모리 측정
-    rep->name = name;
-    rep->memBytes = am_memory_bytes(g);
+// 정렬된 구간에서 중복 제거 후 새 길이 반환
+static size_t unique_ints(int* a, size_t n) {
+    if (n == 0) return 0;
+    size_t k = 1;
+    for (size_t i = 1; i < n; ++i)
+        if (a[i] != a[k - 1]) a[k++] = a[i];
+    return k;
+}
 
-    // 테스트 연산:
-    // 1) 임의 간선 100개 삽입 시도(절반은 존재할 수도, 없을 수도)
-    // 2) 임의 간선 100개 삭제 시도
-    // 3) 연결 여부 확인 1000회
-    // 4) 임의 정점 100개에 대해 인접 노드 나열
-    int trials_ins = 100, trials_del = 100, trials_conn = 1000, trials_nei = 100;
+// 오프셋 누적합: off[0] = 0, off[i+1] = off[i] + cnt[i]
+static void prefix_sum(const uint64_t* cnt, uint64_t* off, int n) {
+    off[0] = 0;
+    for (int i = 0; i < n; ++i) off[i + 1] = off[i] + cnt[i];
+}
 
-    // 삽입 테스트
-    for (int i = 0; i < trials_ins; ++i) {
-        int u = rand() % n, v = rand() % n;
-        if (u == v) { v = (v + 1) % n; }
-        am_insert_edge(g, u, v, &c);
+CsrGraph* build_csr_from_edges(int n, const Edge* E, size_t m) {
+    uint64_t* deg = (uint64_t*)calloc((size_t)n + 1, sizeof(uint64_t));
+    uint64_t* off = (uint64_t*)malloc(((size_t)n + 1) * sizeof(uint64_t));
+    if (!deg || !off) { perror("malloc"); exit(1); }
+
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)m; ++i) {
+        int u = E[i].u, v = E[i].v;
+        if (u == v) continue;
+        __atomic_fetch_add(&deg[u], 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&deg[v], 1, __ATOMIC_RELAXED);
     }
-    // 삭제 테스트
-    for (int i = 0; i < trials_del; ++i) {
-        int u = rand() % n, v = rand() % n;
-        if (u == v) { v = (v + 1) % n; }
+    prefix_sum(deg, off, n);
+
+    // deg를 배치 커서로 재사용
+    memcpy(deg, off, (size_t)n * sizeof(uint64_t));
+    int* tmp = (int*)malloc((off[n] ? off[n] : 1) * sizeof(int));
+    if (!tmp) { perror("malloc"); exit(1); }
+    #pragma omp parallel for schedule(static)
+    for (long long i = 0; i < (long long)m; ++i) {
+        int u = E[i].u, v = E[i].v;
+        if (u == v) continue;
+        tmp[__atomic_fetch_add(&deg[u], 1, __ATOMIC_RELAXED)] = v;
+        tmp[__atomic_fetch_add(&deg[v], 1, __ATOMIC_RELAXED)] = u;
+    }
+
+    // 정점별 정렬 + 중복 제거, 남은 개수를 deg에 기록
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int u = 0; u < n; ++u) {
+        int* a = tmp + off[u];
+        size_t len = (size_t)(off[u + 1] - off[u]);
+        sort_ints(a, len);
+        deg[u] = unique_ints(a, len);
+    }
+
+    CsrGraph* g = (CsrGraph*)malloc(sizeof(CsrGraph));
+    g->n = n;
+    g->off = (uint64_t*)malloc(((size_t)n + 1) * sizeof(uint64_t));
+    prefix_sum(deg, g->off, n);
+    g->m = g->off[n];
+    g->adj = (int*)malloc((g->m ? g->m : 1) * sizeof(int));
+    if (!g->off || !g->adj) { perror("malloc"); exit(1); }
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int u = 0; u < n; ++u) {
+        memcpy(g->adj + g->off[u], tmp + off[u], (size_t)deg[u] * sizeof(int));
+    }
+    free(tmp);
+    free(off);
+    free(deg);
+    return g;
+}
+
+// CSR에서 인접리스트를 선형 시간에 생성(중복 검사 없음).
+// 역순으로 붙여 노드 리스트(AL_UNROLLED=0)가 오름차순이 되게 한다.
+AdjList* build_al_from_csr(const CsrGraph* csr) {
+    AdjList* g = al_create(csr->n);
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int u = 0; u < csr->n; ++u) {
+        for (uint64_t i = csr->off[u + 1]; i > csr->off[u]; --i)
+            al_push_unchecked(g, u, csr->adj[i - 1]);
+    }
+    return g;
+}
+
+AdjList* build_al_from_edges_fast(int n, const Edge* E, size_t m) {
+    CsrGraph* csr = build_csr_from_edges(n, E, m);
+    AdjList* g = build_al_from_csr(csr);
+    csr_free(csr);
+    return g;
+}
+
+// ========================= 동적 그래프(PMA: 간격을 둔 정렬 배열) =========================
+// 방향 간선 키 (u << 32) | v 를 하나의 정렬 배열에 간격을 두고 저장한다.
+// 배열은 segSize 슬롯짜리 세그먼트로 나뉘고, 각 세그먼트는 원소를 왼쪽에 붙여 둔다.
+// 세그먼트가 가득 차면 밀도 임계치를 만족하는 가장 작은 상위 창을 찾아 고르게 재분배하고,
+// 루트도 넘치면 용량을 두 배로 키운다(삽입당 분할상환 O(log^2 n) 이동).
+// 정점 u의 이웃은 연속 구간이므로 CSR처럼 순차 스캔된다.
+
+#define PMA_EMPTY       UINT64_MAX
+#define PMA_MIN_CAP     64
+#define PMA_ROOT_UPPER  0.75    // 루트 창 최대 밀도(리프는 1.0)
+#define PMA_LEAF_LOWER  0.0625  // 리프 최소 밀도(루트는 0.125, 그 아래면 축소 재구축)
+#define PMA_ROOT_LOWER  0.125
+#define PMA_MERGE_DIV   64      // 배치 크기 * 64 >= 원소 수 면 전체 병합 패스
+
+typedef struct {
+    int n;              // 정점 수
+    size_t cap;         // 전체 슬롯 수(2의 거듭제곱)
+    size_t count;       // 저장된 방향 간선 수
+    size_t segSize;     // 세그먼트 슬롯 수(2의 거듭제곱)
+    size_t nseg;        // 세그먼트 수
+    int height;         // 세그먼트 트리 높이 = log2(nseg)
+    uint64_t* slots;
+    uint32_t* segCount; // 세그먼트별 원소 수
+} PmaGraph;
+
+typedef struct {
+    int u, v;
+    bool insert;        // false면 삭제
+} PmaUpdate;
+
+static inline uint64_t pma_key(int u, int v) { return ((uint64_t)(uint32_t)u << 32) | (uint32_t)v; }
+static inline int pma_src(uint64_t k) { return (int)(k >> 32); }
+static inline int pma_dst(uint64_t k) { return (int)(uint32_t)k; }
+
+// 용량을 정하고 정렬된 키 배열 keys[0..k)를 전체에 고르게 배치
+static void pma_layout(PmaGraph* g, const uint64_t* keys, size_t k) {
+    size_t cap = PMA_MIN_CAP;
+    while ((double)k > cap * 0.5) cap *= 2; // 재구축 직후 밀도 <= 0.5
+    size_t seg = 8;
+    while (seg * seg < cap && seg < 256) seg *= 2; // 세그먼트 ~ log(cap) 이상
+    free(g->slots);
+    free(g->segCount);
+    g->cap = cap;
+    g->segSize = seg;
+    g->nseg = cap / seg;
+    g->height = 0;
+    while (((size_t)1 << g->height) < g->nseg) g->height++;
+    g->slots = (uint64_t*)malloc(cap * sizeof(uint64_t));
+    g->segCount = (uint32_t*)calloc(g->nseg, sizeof(uint32_t));
+    if (!g->slots || !g->segCount) { perror("malloc"); exit(1); }
+    g->count = k;
+    #pragma omp parallel for schedule(static)
+    for (long long s = 0; s < (long long)g->nseg; ++s) {
+        size_t from = k * (size_t)s / g->nseg, to = k * ((size_t)s + 1) / g->nseg;
+        uint64_t* dst = g->slots + (size_t)s * seg;
+        for (size_t i = from; i < to; ++i) dst[i - from] = keys[i];
+        for (size_t i = to - from; i < seg; ++i) dst[i] = PMA_EMPTY;
+        g->segCount[s] = (uint32_t)(to - from);
+    }
+}
+
+// 모든 키를 순서대로 꺼낸다(호출자가 free)
+static uint64_t* pma_collect(const PmaGraph* g) {
+    uint64_t* keys = (uint64_t*)malloc((g->count ? g->count : 1) * sizeof(uint64_t));
+    if (!keys) { perror("malloc"); exit(1); }
+    size_t k = 0;
+    for (size_t s = 0; s < g->nseg; ++s) {
+        memcpy(keys + k, g->slots + s * g->segSize, g->segCount[s] * sizeof(uint64_t));
+        k += g->segCount[s];
+    }
+    return keys;
+}
+
+PmaGraph* pma_create(int n) {
+    PmaGraph* g = (PmaGraph*)calloc(1, sizeof(PmaGraph));
+    g->n = n;
+    pma_layout(g, NULL, 0);
+    return g;
+}
+
+void pma_free(PmaGraph* g) {
+    if (!g) return;
+    free(g->slots);
+    free(g->segCount);
+    free(g);
+}
+
+// 첫 키 <= key 인 마지막 비어 있지 않은 세그먼트(없으면 0)
+static size_t pma_find_segment(const PmaGraph* g, uint64_t key) {
+    size_t ans = 0;
+    long long lo = 0, hi = (long long)g->nseg - 1;
+    while (lo <= hi) {
+        long long mid = lo + (hi - lo) / 2, s = mid;
+        while (s >= lo && g->segCount[s] == 0) s--;
+        if (s < lo) { lo = mid + 1; continue; }
+        if (g->slots[(size_t)s * g->segSize] <= key) { ans = (size_t)s; lo = mid + 1; }
+        else hi = s - 1;
+    }
+    return ans;
+}
+
+// 세그먼트 안에서 key 이상인 첫 위치
+static size_t pma_seg_lower(const PmaGraph* g, size_t s, uint64_t key) {
+    const uint64_t* a = g->slots + s * g->segSize;
+    size_t lo = 0, hi = g->segCount[s];
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (a[mid] < key) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+// 창 [s0, s0 + w)의 원소(+ extra 키 하나, 없으면 PMA_EMPTY)를 세그먼트들에 고르게 재분배
+static void pma_spread_window(PmaGraph* g, size_t s0, size_t w, size_t total, uint64_t extra) {
+    uint64_t* tmp = (uint64_t*)malloc((total + 1) * sizeof(uint64_t));
+    if (!tmp) { perror("malloc"); exit(1); }
+    size_t k = 0;
+    bool placed = extra == PMA_EMPTY;
+    for (size_t i = s0; i < s0 + w; ++i) {
+        const uint64_t* a = g->slots + i * g->segSize;
+        for (size_t j = 0; j < g->segCount[i]; ++j) {
+            if (!placed && extra < a[j]) { tmp[k++] = extra; placed = true; }
+            tmp[k++] = a[j];
+        }
+    }
+    if (!placed) tmp[k++] = extra;
+    for (size_t i = 0; i < w; ++i) {
+        size_t from = k * i / w, to = k * (i + 1) / w;
+        uint64_t* dst = g->slots + (s0 + i) * g->segSize;
+        memcpy(dst, tmp + from, (to - from) * sizeof(uint64_t));
+        for (size_t j = to - from; j < g->segSize; ++j) dst[j] = PMA_EMPTY;
+        g->segCount[s0 + i] = (uint32_t)(to - from);
+    }
+    free(tmp);
+}
+
+// 세그먼트 s를 포함하는 창 중 원소 하나를 더 받아도 밀도 상한 안인 가장 작은 창에
+// extra 키를 끼워 고르게 재분배. 루트도 넘치면 전체를 키워 재구축.
+static void pma_rebalance_insert(PmaGraph* g, size_t s, uint64_t extra) {
+    for (int level = 1; level <= g->height; ++level) {
+        size_t w = (size_t)1 << level;
+        size_t s0 = s & ~(w - 1);
+        size_t total = 0;
+        for (size_t i = s0; i < s0 + w; ++i) total += g->segCount[i];
+        double upper = 1.0 - (1.0 - PMA_ROOT_UPPER) * level / g->height;
+        if ((double)(total + 1) > upper * (double)(w * g->segSize)) continue;
+        pma_spread_window(g, s0, w, total, extra);
+        g->count++;
+        return;
+    }
+    // 루트 초과: 키를 모두 꺼내 extra를 병합한 뒤 더 큰 용량으로 재배치
+    uint64_t* keys = pma_collect(g);
+    uint64_t* all = (uint64_t*)malloc((g->count + 1) * sizeof(uint64_t));
+    if (!all) { perror("malloc"); exit(1); }
+    size_t i = 0, k = 0;
+    while (i < g->count && keys[i] < extra) all[k++] = keys[i++];
+    all[k++] = extra;
+    while (i < g->count) all[k++] = keys[i++];
+    pma_layout(g, all, k);
+    free(keys);
+    free(all);
+}
+
+static bool pma_insert_key(PmaGraph* g, uint64_t key) {
+    size_t s = pma_find_segment(g, key);
+    size_t pos = pma_seg_lower(g, s, key);
+    uint64_t* a = g->slots + s * g->segSize;
+    if (pos < g->segCount[s] && a[pos] == key) return false;
+    if (g->segCount[s] == g->segSize) {
+        pma_rebalance_insert(g, s, key);
+        return true;
+    }
+    memmove(a + pos + 1, a + pos, (g->segCount[s] - pos) * sizeof(uint64_t));
+    a[pos] = key;
+    g->segCount[s]++;
+    g->count++;
+    return true;
+}
+
+static bool pma_delete_key(PmaGraph* g, uint64_t key) {
+    size_t s = pma_find_segment(g, key);
+    size_t pos = pma_seg_lower(g, s, key);
+    uint64_t* a = g->slots + s * g->segSize;
+    if (pos >= g->segCount[s] || a[pos] != key) return false;
+    memmove(a + pos, a + pos + 1, (g->segCount[s] - pos - 1) * sizeof(uint64_t));
+    g->segCount[s]--;
+    a[g->segCount[s]] = PMA_EMPTY;
+    g->count--;
+    // 전체가 너무 성기면 작은 용량으로 재구축
+    if (g->cap > PMA_MIN_CAP && (double)g->count < PMA_ROOT_LOWER * g->cap) {
+        uint64_t* keys = pma_collect(g);
+        pma_layout(g, keys, g->count);
+        free(keys);
+        return true;
+    }
+    // 세그먼트가 하한 밑이면 밀도 하한을 만족하는 가장 작은 창에서 재분배
+    if ((double)g->segCount[s] < PMA_LEAF_LOWER * g->segSize) {
+        for (int level = 1; level <= g->height; ++level) {
+            size_t w = (size_t)1 << level;
+            size_t s0 = s & ~(w - 1);
+            size_t total = 0;
+            for (size_t i = s0; i < s0 + w; ++i) total += g->segCount[i];
+            double lower = PMA_LEAF_LOWER + (PMA_ROOT_LOWER - PMA_LEAF_LOWER) * level / g->height;
+            if ((double)total < lower * (double)(w * g->segSize)) continue;
+            pma_spread_window(g, s0, w, total, PMA_EMPTY);
+            break;
+        }
+    }
+    return true;
+}
+
+// 비교 정의: 세그먼트 이분 탐색을 제외한 세그먼트 내 키 비교 1회
+bool pma_has_edge(PmaGraph* g, int u, int v, Counters* c) {
+    uint64_t key = pma_key(u, v);
+    size_t s = pma_find_segment(g, key);
+    size_t pos = pma_seg_lower(g, s, key);
+    c->cmp_connected += 1;
+    return pos < g->segCount[s] && g->slots[s * g->segSize + pos] == key;
+}
+
+bool pma_insert_edge(PmaGraph* g, int u, int v, Counters* c) {
+    c->cmp_insert_delete += 1;
+    if (!pma_insert_key(g, pma_key(u, v))) return false;
+    pma_insert_key(g, pma_key(v, u));
+    return true;
+}
+
+bool pma_delete_edge(PmaGraph* g, int u, int v, Counters* c) {
+    c->cmp_insert_delete += 1;
+    if (!pma_delete_key(g, pma_key(u, v))) return false;
+    pma_delete_key(g, pma_key(v, u));
+    return true;
+}
+
+int pma_neighbors(PmaGraph* g, int u, int* out, int cap, Counters* c) {
+    uint64_t key = pma_key(u, 0);
+    size_t s = pma_find_segment(g, key);
+    size_t j = pma_seg_lower(g, s, key);
+    int count = 0;
+    for (; s < g->nseg; ++s, j = 0) {
+        const uint64_t* a = g->slots + s * g->segSize;
+        for (; j < g->segCount[s]; ++j) {
+            if (pma_src(a[j]) != u) return count;
+            c->cmp_neighbors += 1;
+            if (count < cap) out[count] = pma_dst(a[j]);
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t pma_memory_bytes(PmaGraph* g) {
+    return sizeof(PmaGraph) + g->cap * sizeof(uint64_t) + g->nseg * sizeof(uint32_t);
+}
+
+typedef struct {
+    uint64_t key;
+    size_t seq;         // 같은 키는 배치 안에서 나중 연산이 이긴다
+    bool insert;
+} PmaOp;
+
+static int cmp_pma_op(const void* a, const void* b) {
+    const PmaOp* x = (const PmaOp*)a;
+    const PmaOp* y = (const PmaOp*)b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    return (x->seq > y->seq) - (x->seq < y->seq);
+}
+
+// 삽입/삭제 배치 적용. 배치를 정렬한 뒤, 기존 원소 수에 비해 크면 기존 키와 한 번에
+// 병합하여 새 간격으로 재배치하고, 작으면 키마다 국소 삽입/삭제한다. 변경된 방향 키 수 반환.
+size_t pma_apply_batch(PmaGraph* g, const PmaUpdate* ups, size_t k) {
+    PmaOp* ops = (PmaOp*)malloc((2 * k + 1) * sizeof(PmaOp));
+    if (!ops) { perror("malloc"); exit(1); }
+    size_t no = 0;
+    for (size_t i = 0; i < k; ++i) {
+        if (ups[i].u == ups[i].v) continue;
+        ops[no].key = pma_key(ups[i].u, ups[i].v); ops[no].seq = i; ops[no].insert = ups[i].insert; no++;
+        ops[no].key = pma_key(ups[i].v, ups[i].u); ops[no].seq = i; ops[no].insert = ups[i].insert; no++;
+    }
+    qsort(ops, no, sizeof(PmaOp), cmp_pma_op);
+    size_t uo = 0;
+    for (size_t i = 0; i < no; ++i) {
+        if (uo > 0 && ops[uo - 1].key == ops[i].key) ops[uo - 1] = ops[i];
+        else ops[uo++] = ops[i];
+    }
+
+    size_t changed = 0;
+    if (uo * PMA_MERGE_DIV >= g->count) {
+        uint64_t* out = (uint64_t*)malloc((g->count + uo + 1) * sizeof(uint64_t));
+        if (!out) { perror("malloc"); exit(1); }
+        size_t k2 = 0, oi = 0;
+        for (size_t s = 0; s < g->nseg; ++s) {
+            const uint64_t* a = g->slots + s * g->segSize;
+            for (size_t j = 0; j < g->segCount[s]; ++j) {
+                while (oi < uo && ops[oi].key < a[j]) {
+                    if (ops[oi].insert) { out[k2++] = ops[oi].key; changed++; }
+                    oi++;
+                }
+                if (oi < uo && ops[oi].key == a[j]) {
+                    if (ops[oi].insert) out[k2++] = a[j];
+                    else changed++;
+                    oi++;
+                } else {
+                    out[k2++] = a[j];
+                }
+            }
+        }
+        for (; oi < uo; ++oi)
+            if (ops[oi].insert) { out[k2++] = ops[oi].key; changed++; }
+        pma_layout(g, out, k2);
+        free(out);
+    } else {
+        for (size_t i = 0; i < uo; ++i)
+            changed += ops[i].insert ? pma_insert_key(g, ops[i].key) : pma_delete_key(g, ops[i].key);
+    }
+    free(ops);
+    return changed;
+}
+
+// ========================= 그래프 뷰(백엔드 공통 순회 인터페이스) =========================
+// 순회/분석 알고리즘이 인접행렬·비트행렬·인접리스트·CSR 어느 것에서도 돌도록 하는 얇은 래퍼.
+
+typedef enum { GV_MATRIX, GV_BITMATRIX, GV_LIST, GV_CSR, GV_PMA } GraphKind;
+
+typedef struct {
+    GraphKind kind;
+    int n;
+    void* g;
+} GraphView;
+
+static inline GraphView gv_matrix(AdjMatrix* g)    { GraphView v = { GV_MATRIX, g->n, g }; return v; }
+static inline GraphView gv_bitmatrix(BitMatrix* g) { GraphView v = { GV_BITMATRIX, g->n, g }; return v; }
+static inline GraphView gv_list(AdjList* g)        { GraphView v = { GV_LIST, g->n, g }; return v; }
+static inline GraphView gv_csr(CsrGraph* g)        { GraphView v = { GV_CSR, g->n, g }; return v; }
+static inline GraphView gv_pma(PmaGraph* g)        { GraphView v = { GV_PMA, g->n, g }; return v; }
+
+// u의 이웃 배열을 돌려준다. CSR은 내부 배열을 그대로, 나머지는 buf(용량 cap)에 채운다.
+static const int* gv_adj(const GraphView* G, int u, int* buf, int cap, int* deg) {
+    Counters c; resetCounters(&c); // 분석 경로에서는 비교 횟수를 버린다
+    switch (G->kind) {
+    case GV_MATRIX:    *deg = am_neighbors((AdjMatrix*)G->g, u, buf, cap, &c); return buf;
+    case GV_BITMATRIX: *deg = bm_neighbors((BitMatrix*)G->g, u, buf, cap, &c); return buf;
+    case GV_LIST:      *deg = al_neighbors((AdjList*)G->g, u, buf, cap, &c); return buf;
+    case GV_PMA:       *deg = pma_neighbors((PmaGraph*)G->g, u, buf, cap, &c); return buf;
+    case GV_CSR: {
+        const CsrGraph* g = (const CsrGraph*)G->g;
+        *deg = csr_degree(g, u);
+        return g->adj + g->off[u];
+    }
+    }
+    *deg = 0;
+    return buf;
+}
+
+// 정점별 차수 배열(호출자가 free). 최대 차수를 *maxDeg에 기록.
+static int* gv_degrees(const GraphView* G, int* maxDeg) {
+    int* deg = (int*)malloc((size_t)G->n * sizeof(int));
+    if (!deg) { perror("malloc"); exit(1); }
+    int best = 0;
+    #pragma omp parallel for schedule(dynamic, 256) reduction(max:best)
+    for (int u = 0; u < G->n; ++u) {
+        Counters c; resetCounters(&c);
+        int d = 0;
+        switch (G->kind) {
+        case GV_MATRIX:    d = am_neighbors((AdjMatrix*)G->g, u, NULL, 0, &c); break;
+        case GV_BITMATRIX: d = bm_degree((BitMatrix*)G->g, u); break;
+        case GV_LIST:      d = al_neighbors((AdjList*)G->g, u, NULL, 0, &c); break;
+        case GV_CSR:       d = csr_degree((CsrGraph*)G->g, u); break;
+        case GV_PMA:       d = pma_neighbors((PmaGraph*)G->g, u, NULL, 0, &c); break;
+        }
+        deg[u] = d;
+        if (d > best) best = d;
+    }
+    if (maxDeg) *maxDeg = best;
+    return deg;
+}
+
+// 스레드별 이웃 버퍼(CSR은 필요 없음)
+static int** gv_alloc_buffers(const GraphView* G, int cap) {
+    int T = thread_count();
+    int** bufs = (int**)calloc((size_t)T, sizeof(int*));
+    if (G->kind == GV_CSR) return bufs;
+    for (int t = 0; t < T; ++t) {
+        bufs[t] = (int*)malloc(((size_t)cap + 1) * sizeof(int));
+        if (!bufs[t]) { perror("malloc"); exit(1); }
+    }
+    return bufs;
+}
+
+static void gv_free_buffers(int** bufs) {
+    int T = thread_count();
+    for (int t = 0; t < T; ++t) free(bufs[t]);
+    free(bufs);
+}
+
+// ========================= 이진 그래프 파일 저장/불러오기 =========================
+// 형식은 graph_file.h 참고. 불러오기는 mmap 제로 카피.
+
+// 임의 백엔드를 CSR로 복사(이웃은 정렬)
+CsrGraph* csr_from_view(const GraphView* G) {
+    int n = G->n, maxDeg = 0;
+    int* deg = gv_degrees(G, &maxDeg);
+    int** bufs = gv_alloc_buffers(G, maxDeg);
+    CsrGraph* g = (CsrGraph*)malloc(sizeof(CsrGraph));
+    g->n = n;
+    g->off = (uint64_t*)malloc(((size_t)n + 1) * sizeof(uint64_t));
+    if (!g->off) { perror("malloc"); exit(1); }
+    g->off[0] = 0;
+    for (int u = 0; u < n; ++u) g->off[u + 1] = g->off[u] + (uint64_t)deg[u];
+    g->m = g->off[n];
+    g->adj = (int*)malloc((g->m ? g->m : 1) * sizeof(int));
+    if (!g->adj) { perror("malloc"); exit(1); }
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int u = 0; u < n; ++u) {
+        int d;
+        const int* nb = gv_adj(G, u, bufs[thread_id()], maxDeg, &d);
+        memcpy(g->adj + g->off[u], nb, (size_t)d * sizeof(int));
+        sort_ints(g->adj + g->off[u], (size_t)d);
+    }
+    gv_free_buffers(bufs);
+    free(deg);
+    return g;
+}
+
+bool gv_save(const GraphView* G, const char* path) {
+    if (G->kind == GV_CSR) {
+        const CsrGraph* g = (const CsrGraph*)G->g;
+        return gf_write(path, (uint64_t)g->n, g->off, g->adj, NULL);
+    }
+    CsrGraph* g = csr_from_view(G);
+    bool ok = gf_write(path, (uint64_t)g->n, g->off, g->adj, NULL);
+    csr_free(g);
+    return ok;
+}
+
+// 매핑된 파일을 CsrGraph로 감싼다. 배열은 읽기 전용 매핑을 그대로 가리키므로
+// 결과를 수정하거나 csr_free 하면 안 된다(gf_close로 해제).
+// int로 바꿀 수 없는 정점 수면 false. verify면 이웃 번호가 모두 [0, n) 안인지도 확인하는데,
+// adj 전체를 읽는 O(m) 작업이라 매핑만으로 바로 쓰는 장점이 사라지므로 믿을 수 없는 파일에만 쓴다.
+bool csr_view_of_file(const GraphFile* gf, CsrGraph* g, bool verify) {
+    if (gf->n > (uint64_t)INT_MAX) {
+        fprintf(stderr, "[ERR] 정점 수가 너무 큽니다: %llu\n", (unsigned long long)gf->n);
+        return false;
+    }
+    int n = (int)gf->n;
+    for (uint64_t i = 0; verify && i < gf->m; ++i) {
+        if (gf->adj[i] < 0 || gf->adj[i] >= n) {
+            fprintf(stderr, "[ERR] 잘못된 이웃 번호: adj[%llu] = %d\n", (unsigned long long)i, gf->adj[i]);
+            return false;
+        }
+    }
+    g->n = n;
+    g->m = (size_t)gf->m;
+    g->off = (uint64_t*)gf->off;
+    g->adj = (int*)gf->adj;
+    return true;
+}
+
+// ========================= 방향 최적화 BFS =========================
+// 프런티어가 작을 때는 top-down(큐), 커지면 bottom-up(비트맵)으로 전환(Beamer 휴리스틱).
+#define BFS_ALPHA 14
+#define BFS_BETA  24
+
+typedef struct {
+    int td_steps;   // top-down 단계 수
+    int bu_steps;   // bottom-up 단계 수
+} BfsStats;
+
+static inline bool bit_test(const uint64_t* b, int i) { return (b[i >> 6] >> (i & 63)) & 1u; }
+static inline void bit_set_atomic(uint64_t* b, int i) {
+    __atomic_fetch_or(&b[i >> 6], 1ull << (i & 63), __ATOMIC_RELAXED);
+}
+
+// parent/depth는 크기 n(도달 불가 = -1). 도달한 정점 수 반환.
+int bfs_direction_optimizing(const GraphView* G, int src, int* parent, int* depth, BfsStats* st) {
+    int n = G->n, maxDeg = 0;
+    int* deg = gv_degrees(G, &maxDeg);
+    int** bufs = gv_alloc_buffers(G, maxDeg);
+    int words = (n + 63) / 64;
+    int* queue = (int*)malloc((size_t)n * sizeof(int));
+    int* nextq = (int*)malloc((size_t)n * sizeof(int));
+    uint64_t* front = (uint64_t*)calloc((size_t)words, sizeof(uint64_t));
+    uint64_t* nextb = (uint64_t*)calloc((size_t)words, sizeof(uint64_t));
+    if (!queue || !nextq || !front || !nextb) { perror("malloc"); exit(1); }
+
+    long long mu = 0; // 미방문 정점들의 차수 합
+    #pragma omp parallel for reduction(+:mu)
+    for (int v = 0; v < n; ++v) { parent[v] = -1; depth[v] = -1; mu += deg[v]; }
+    parent[src] = src; depth[src] = 0;
+    mu -= deg[src];
+    queue[0] = src;
+    int nf = 1, level = 0, reached = 1;
+    long long mf = deg[src];
+    bool bottomUp = false;
+    if (st) { st->td_steps = 0; st->bu_steps = 0; }
+
+    while (nf > 0) {
+        if (!bottomUp && mf > mu / BFS_ALPHA) {
+            // 큐 -> 비트맵
+            memset(front, 0, (size_t)words * sizeof(uint64_t));
+            for (int i = 0; i < nf; ++i) front[queue[i] >> 6] |= 1ull << (queue[i] & 63);
+            bottomUp = true;
+        } else if (bottomUp && nf < n / BFS_BETA) {
+            // 비트맵 -> 큐
+            int k = 0;
+            for (int w = 0; w < words; ++w)
+                for (uint64_t x = front[w]; x; x &= x - 1) queue[k++] = (w << 6) + ctz64(x);
+            nf = k;
+            bottomUp = false;
+        }
+
+        int newCount = 0;
+        long long newDeg = 0;
+        if (!bottomUp) {
+            if (st) st->td_steps++;
+            #pragma omp parallel for schedule(dynamic, 64) reduction(+:newDeg)
+            for (int i = 0; i < nf; ++i) {
+                int u = queue[i], d;
+                const int* nb = gv_adj(G, u, bufs[thread_id()], maxDeg, &d);
+                for (int k = 0; k < d; ++k) {
+                    int v = nb[k];
+                    int expect = -1;
+                    if (parent[v] == -1 &&
+                        __atomic_compare_exchange_n(&parent[v], &expect, u, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                        depth[v] = level + 1;
+                        nextq[__atomic_fetch_add(&newCount, 1, __ATOMIC_RELAXED)] = v;
+                        newDeg += deg[v];
+                    }
+                }
+            }
+            int* t = queue; queue = nextq; nextq = t;
+        } else {
+            if (st) st->bu_steps++;
+            memset(nextb, 0, (size_t)words * sizeof(uint64_t));
+            #pragma omp parallel for schedule(dynamic, 256) reduction(+:newCount, newDeg)
+            for (int v = 0; v < n; ++v) {
+                if (parent[v] != -1) continue;
+                int d;
+                const int* nb = gv_adj(G, v, bufs[thread_id()], maxDeg, &d);
+                for (int k = 0; k < d; ++k) {
+                    if (bit_test(front, nb[k])) {
+                        parent[v] = nb[k];
+                        depth[v] = level + 1;
+                        bit_set_atomic(nextb, v);
+                        newCount++;
+                        newDeg += deg[v];
+                        break;
+                    }
+                }
+            }
+            uint64_t* t = front; front = nextb; nextb = t;
+        }
+        nf = newCount;
+        mf = newDeg;
+        mu -= newDeg;
+        reached += newCount;
+        level++;
+    }
+
+    free(queue); free(nextq); free(front); free(nextb);
+    gv_free_buffers(bufs);
+    free(deg);
+    return reached;
+}
+
+// ========================= 연결 요소(동시 union-find) =========================
+// 간선마다 CAS로 큰 루트를 작은 루트 밑에 붙인다. 경로 절반 압축도 CAS로 수행.
+
+static int uf_find(int* p, int x) {
+    for (;;) {
+        int px = __atomic_load_n(&p[x], __ATOMIC_RELAXED);
+        if (px == x) return x;
+        int ppx = __atomic_load_n(&p[px], __ATOMIC_RELAXED);
+        if (ppx != px)
+            __atomic_compare_exchange_n(&p[x], &px, ppx, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+        x = ppx;
+    }
+}
+
+static void uf_union(int* p, int a, int b) {
+    for (;;) {
+        int ra = uf_find(p, a), rb = uf_find(p, b);
+        if (ra == rb) return;
+        if (ra < rb) { int t = ra; ra = rb; rb = t; }
+        int expect = ra;
+        if (__atomic_compare_exchange_n(&p[ra], &expect, rb, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            return;
+    }
+}
+
+// label[v] = v가 속한 요소의 대표(가장 작은 정점 번호). 요소 수 반환.
+int connected_components(const GraphView* G, int* label) {
+    int n = G->n, maxDeg = 0;
+    int* deg = gv_degrees(G, &maxDeg);
+    int** bufs = gv_alloc_buffers(G, maxDeg);
+    free(deg);
+
+    #pragma omp parallel for
+    for (int v = 0; v < n; ++v) label[v] = v;
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int u = 0; u < n; ++u) {
+        int d;
+        const int* nb = gv_adj(G, u, bufs[thread_id()], maxDeg, &d);
+        for (int k = 0; k < d; ++k)
+            if (nb[k] > u) uf_union(label, u, nb[k]);
+    }
+
+    int comps = 0;
+    #pragma omp parallel for reduction(+:comps)
+    for (int v = 0; v < n; ++v) {
+        if (uf_find(label, v) == v) comps++;
+    }
+    #pragma omp parallel for
+    for (int v = 0; v < n; ++v) label[v] = uf_find(label, v);
+
+    gv_free_buffers(bufs);
+    return comps;
+}
+
+// ========================= 정점 재번호 / 공통 이웃 / 삼각형 =========================
+
+// newId[u] = u의 새 번호로 재번호한 CSR(각 이웃 목록은 다시 오름차순 정렬)
+CsrGraph* csr_relabel(const CsrGraph* g, const int* newId) {
+    int n = g->n;
+    uint64_t* cnt = (uint64_t*)malloc(((size_t)n + 1) * sizeof(uint64_t));
+    CsrGraph* r = (CsrGraph*)malloc(sizeof(CsrGraph));
+    r->n = n;
+    r->m = g->m;
+    r->off = (uint64_t*)malloc(((size_t)n + 1) * sizeof(uint64_t));
+    r->adj = (int*)malloc((g->m ? g->m : 1) * sizeof(int));
+    if (!cnt || !r->off || !r->adj) { perror("malloc"); exit(1); }
+    for (int u = 0; u < n; ++u) cnt[newId[u]] = (uint64_t)csr_degree(g, u);
+    prefix_sum(cnt, r->off, n);
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int u = 0; u < n; ++u) {
+        int* dst = r->adj + r->off[newId[u]];
+        size_t d = 0;
+        for (uint64_t i = g->off[u]; i < g->off[u + 1]; ++i) dst[d++] = newId[g->adj[i]];
+        sort_ints(dst, d);
+    }
+    free(cnt);
+    return r;
+}
+
+// 차수 오름차순(동률은 번호 순) 재번호: 계수 정렬로 선형 시간
+int* degree_order(const CsrGraph* g) {
+    int n = g->n, maxDeg = 0;
+    for (int u = 0; u < n; ++u) if (csr_degree(g, u) > maxDeg) maxDeg = csr_degree(g, u);
+    int* bucket = (int*)calloc((size_t)maxDeg + 2, sizeof(int));
+    int* newId = (int*)malloc((size_t)n * sizeof(int));
+    if (!bucket || !newId) { perror("malloc"); exit(1); }
+    for (int u = 0; u < n; ++u) bucket[csr_degree(g, u) + 1]++;
+    for (int d = 0; d <= maxDeg; ++d) bucket[d + 1] += bucket[d];
+    for (int u = 0; u < n; ++u) newId[u] = bucket[csr_degree(g, u)]++;
+    free(bucket);
+    return newId;
+}
+
+// 정렬된 두 배열의 교집합 크기(병합)
+static long long merge_count(const int* a, size_t na, const int* b, size_t nb) {
+    size_t i = 0, j = 0;
+    long long c = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) i++;
+        else if (a[i] > b[j]) j++;
+        else { c++; i++; j++; }
+    }
+    return c;
+}
+
+// 공통 이웃 수. 비트행렬이 있고 두 정점의 차수 합이 행 워드 수 이상이면
+// AND + popcount(행렬 방식), 아니면 정렬 병합(리스트 방식)을 고른다.
+int common_neighbors(const CsrGraph* g, const BitMatrix* bm, int u, int v) {
+    int du = csr_degree(g, u), dv = csr_degree(g, v);
+    if (bm && du + dv >= bm->words) return bm_common_neighbors(bm, u, v);
+    return (int)merge_count(g->adj + g->off[u], (size_t)du, g->adj + g->off[v], (size_t)dv);
+}
+
+// Jaccard 유사도 |N(u) ∩ N(v)| / |N(u) ∪ N(v)|
+double jaccard(const CsrGraph* g, const BitMatrix* bm, int u, int v) {
+    int c = common_neighbors(g, bm, u, v);
+    int uni = csr_degree(g, u) + csr_degree(g, v) - c;
+    return uni > 0 ? (double)c / uni : 0.0;
+}
+
+// 정렬된 목록에서 x보다 큰 첫 위치
+static uint64_t upper_index(const int* adj, uint64_t lo, uint64_t hi, int x) {
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        if (adj[mid] <= x) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+#define TRI_DENSE_DIV 64    // 차수 * 64 >= n 이면 밀집 정점(비트셋 후보)
+
+// 삼각형 수. 차수 오름차순으로 재번호한 뒤 간선을 작은 번호 -> 큰 번호로 향하게 하면
+// 각 삼각형은 u < v < w 에서 |out(u) ∩ out(v)| 로 정확히 한 번 센다.
+// 이때 out(v) = N(v) ∩ (v, n) 이므로 밀집 정점끼리는 (v 이후 비트만 남긴) 행 AND + popcount로,
+// 나머지는 out 목록 병합으로 센다. useBitset == false면 병합만 사용.
+long long count_triangles(const CsrGraph* g0, bool useBitset) {
+    int* newId = degree_order(g0);
+    CsrGraph* g = csr_relabel(g0, newId);
+    free(newId);
+    int n = g->n;
+
+    // 밀집 정점은 차수 순서상 번호가 가장 큰 쪽에 모여 있다: [h0, n)
+    int h0 = n;
+    while (h0 > 0 && (long long)csr_degree(g, h0 - 1) * TRI_DENSE_DIV >= n) h0--;
+    int words = (n + 63) / 64;
+    uint64_t* rows = NULL;
+    if (useBitset && h0 < n) {
+        rows = (uint64_t*)calloc((size_t)(n - h0) * (size_t)words, sizeof(uint64_t));
+        if (rows) {
+            #pragma omp parallel for schedule(dynamic, 16)
+            for (int u = h0; u < n; ++u) {
+                uint64_t* r = rows + (size_t)(u - h0) * words;
+                for (uint64_t i = g->off[u]; i < g->off[u + 1]; ++i)
+                    r[g->adj[i] >> 6] |= 1ull << (g->adj[i] & 63);
+            }
+        }
+    }
+
+    long long total = 0;
+    #pragma omp parallel for schedule(dynamic, 64) reduction(+:total)
+    for (int u = 0; u < n; ++u) {
+        uint64_t su = upper_index(g->adj, g->off[u], g->off[u + 1], u);
+        const int* ou = g->adj + su;
+        size_t nu = (size_t)(g->off[u + 1] - su);
+        for (size_t k = 0; k < nu; ++k) {
+            int v = ou[k];
+            if (rows && u >= h0) {
+                // v < w 인 w만: 첫 워드는 v 이후 비트만 남긴다
+                const uint64_t* ru = rows + (size_t)(u - h0) * words;
+                const uint64_t* rv = rows + (size_t)(v - h0) * words;
+                int w0 = (v + 1) >> 6;
+                if (w0 < words) {
+                    uint64_t mask = ~0ull << ((v + 1) & 63);
+                    total += popcount64(ru[w0] & rv[w0] & mask);
+                    total += bm_and_popcount(ru, rv, w0 + 1, words);
+                }
+            } else {
+                uint64_t sv = upper_index(g->adj, g->off[v], g->off[v + 1], v);
+                total += merge_count(ou + k + 1, nu - k - 1, g->adj + sv, (size_t)(g->off[v + 1] - sv));
+            }
+        }
+    }
+    free(rows);
+    csr_free(g);
+    return total;
+}
+
+// ========================= PageRank(SpMV 거듭제곱 반복) =========================
+// rank_{t+1} = (1 - d)/n + d * (A^T D^{-1} rank_t + dangling/n).
+// pull: 정점마다 이웃 기여를 모아 더한다(쓰기 경합 없음).
+// push: 정점마다 자기 기여를 이웃에 뿌린다(원자적 덧셈).
+// useFloat면 기여 벡터를 float32로 두고 AVX2 gather로 8개씩 합산(메모리 대역폭 절반).
+// gather가 이득인 pull 전용이며 push에서는 무시한다(정점마다 기여를 한 번 순차로 읽을 뿐이라).
+
+typedef enum { PR_PULL, PR_PUSH } PrMode;
+
+typedef struct {
+    int iters;          // 수행한 반복 수
+    double seconds;     // 전체 반복 시간
+    double delta;       // 마지막 반복의 L1 변화량
+} PrStats;
+
+static inline void atomic_add_double(double* p, double x) {
+    uint64_t old = __atomic_load_n((uint64_t*)p, __ATOMIC_RELAXED), neu;
+    do {
+        double v;
+        memcpy(&v, &old, sizeof(v));
+        v += x;
+        memcpy(&neu, &v, sizeof(neu));
+    } while (!__atomic_compare_exchange_n((uint64_t*)p, &old, neu, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+// float32 기여 벡터에서 nb[0..d) 위치 값의 합
+static inline float gather_sum_f32(const int* nb, int d, const float* x) {
+    int k = 0;
+    float s = 0.0f;
+#ifdef __AVX2__
+    __m256 acc = _mm256_setzero_ps();
+    for (; k + 8 <= d; k += 8) {
+        __m256i idx = _mm256_loadu_si256((const __m256i*)(nb + k));
+        acc = _mm256_add_ps(acc, _mm256_i32gather_ps(x, idx, 4));
+    }
+    float lanes[8];
+    _mm256_storeu_ps(lanes, acc);
+    for (int i = 0; i < 8; ++i) s += lanes[i];
+#endif
+    for (; k < d; ++k) s += x[nb[k]];
+    return s;
+}
+
+// rank(크기 n)에 결과를 쓴다. deltaHist가 있으면 반복별 L1 변화량 기록. 수행한 반복 수 반환.
+int pagerank(const GraphView* G, PrMode mode, bool useFloat, double damping, double tol, int maxIter,
+             double* rank, double* deltaHist, PrStats* st) {
+    int n = G->n, maxDeg = 0;
+    int* deg = gv_degrees(G, &maxDeg);
+    int** bufs = gv_alloc_buffers(G, maxDeg);
+    double* next = (double*)malloc((size_t)n * sizeof(double));
+    double* contrib = (double*)malloc((size_t)n * sizeof(double));
+    if (mode != PR_PULL) useFloat = false;
+    float* contribF = useFloat ? (float*)malloc((size_t)n * sizeof(float)) : NULL;
+    if (!next || !contrib || (useFloat && !contribF)) { perror("malloc"); exit(1); }
+
+    #pragma omp parallel for
+    for (int v = 0; v < n; ++v) rank[v] = 1.0 / n;
+
+    bool single = thread_count() == 1; // 한 스레드면 push에 원자적 연산 불필요
+    double t0 = now_sec(), delta = 0.0;
+    int it = 0;
+    while (it < maxIter) {
+        double dangling = 0.0;
+        #pragma omp parallel for reduction(+:dangling)
+        for (int u = 0; u < n; ++u) {
+            double c = deg[u] ? rank[u] / deg[u] : 0.0;
+            if (!deg[u]) dangling += rank[u];
+            if (contribF) contribF[u] = (float)c; else contrib[u] = c;
+        }
+        double base = (1.0 - damping) / n + damping * dangling / n;
+
+        if (mode == PR_PULL) {
+            #pragma omp parallel for schedule(dynamic, 256)
+            for (int v = 0; v < n; ++v) {
+                int d;
+                const int* nb = gv_adj(G, v, bufs[thread_id()], maxDeg, &d);
+                double sum = 0.0;
+                if (contribF) sum = gather_sum_f32(nb, d, contribF);
+                else for (int k = 0; k < d; ++k) sum += contrib[nb[k]];
+                next[v] = base + damping * sum;
+            }
+        } else {
+            #pragma omp parallel for
+            for (int v = 0; v < n; ++v) next[v] = 0.0;
+            #pragma omp parallel for schedule(dynamic, 256)
+            for (int u = 0; u < n; ++u) {
+                int d;
+                const int* nb = gv_adj(G, u, bufs[thread_id()], maxDeg, &d);
+                double c = contrib[u];
+                if (single) for (int k = 0; k < d; ++k) next[nb[k]] += c;
+                else for (int k = 0; k < d; ++k) atomic_add_double(&next[nb[k]], c);
+            }
+            #pragma omp parallel for
+            for (int v = 0; v < n; ++v) next[v] = base + damping * next[v];
+        }
+
+        delta = 0.0;
+        #pragma omp parallel for reduction(+:delta)
+        for (int v = 0; v < n; ++v) {
+            delta += fabs(next[v] - rank[v]);
+            rank[v] = next[v];
+        }
+        if (deltaHist) deltaHist[it] = delta;
+        it++;
+        if (delta < tol) break;
+    }
+    if (st) {
+        st->iters = it;
+        st->seconds = now_sec() - t0;
+        st->delta = delta;
+    }
+    free(contribF); free(contrib); free(next);
+    gv_free_buffers(bufs);
+    free(deg);
+    return it;
+}
+
+// ========================= 지역성을 위한 정점 재배치 =========================
+// 순열을 계산해 그래프를 재번호한다. VertexMap으로 원래 번호 <-> 내부 번호를 오간다.
+
+typedef enum { REORDER_DEGREE, REORDER_RCM, REORDER_BFS } ReorderKind;
+
+typedef struct {
+    int n;
+    int* newOf;     // 원래 번호 -> 내부 번호
+    int* oldOf;     // 내부 번호 -> 원래 번호
+} VertexMap;
+
+static inline int vmap_to_internal(const VertexMap* mp, int orig) { return mp->newOf[orig]; }
+static inline int vmap_to_original(const VertexMap* mp, int id) { return mp->oldOf[id]; }
+
+void vmap_free(VertexMap* mp) {
+    free(mp->newOf);
+    free(mp->oldOf);
+    mp->newOf = mp->oldOf = NULL;
+}
+
+static int cmp_u64_asc(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+// 방문 순서 order[0..n)에서 매핑 생성
+static VertexMap vmap_from_order(int* order, int n) {
+    VertexMap mp;
+    mp.n = n;
+    mp.oldOf = order;
+    mp.newOf = (int*)malloc((size_t)n * sizeof(int));
+    if (!mp.newOf) { perror("malloc"); exit(1); }
+    for (int i = 0; i < n; ++i) mp.newOf[order[i]] = i;
+    return mp;
+}
+
+// BFS 방문 순서로 order를 채운다. byDegree면 (역)Cuthill–McKee처럼
+// 각 정점의 미방문 이웃을 차수 오름차순으로 넣고, 요소 시작점도 최소 차수 정점을 고른다.
+static void bfs_order(const CsrGraph* g, bool byDegree, int* order) {
+    int n = g->n;
+    char* seen = (char*)calloc((size_t)n, 1);
+    uint64_t* tmp = (uint64_t*)malloc(((size_t)n + 1) * sizeof(uint64_t));
+    int* starts = NULL;
+    if (byDegree) {
+        // 차수 오름차순 정점 목록(degree_order의 역순열)
+        int* rank = degree_order(g);
+        starts = (int*)malloc((size_t)n * sizeof(int));
+        for (int u = 0; u < n; ++u) starts[rank[u]] = u;
+        free(rank);
+    }
+    if (!seen || !tmp) { perror("malloc"); exit(1); }
+    int head = 0, tail = 0;
+    for (int si = 0; si < n; ++si) {
+        int s = starts ? starts[si] : si;
+        if (seen[s]) continue;
+        seen[s] = 1;
+        order[tail++] = s;
+        while (head < tail) {
+            int u = order[head++];
+            int k = 0;
+            for (uint64_t i = g->off[u]; i < g->off[u + 1]; ++i) {
+                int v = g->adj[i];
+                if (seen[v]) continue;
+                seen[v] = 1;
+                tmp[k++] = ((uint64_t)csr_degree(g, v) << 32) | (uint32_t)v;
+            }
+            if (byDegree && k > 1) qsort(tmp, (size_t)k, sizeof(uint64_t), cmp_u64_asc);
+            for (int i = 0; i < k; ++i) order[tail++] = (int)(uint32_t)tmp[i];
+        }
+    }
+    free(starts);
+    free(tmp);
+    free(seen);
+}
+
+VertexMap reorder_compute(const CsrGraph* g, ReorderKind kind) {
+    int n = g->n;
+    int* order = (int*)malloc((size_t)n * sizeof(int));
+    if (!order) { perror("malloc"); exit(1); }
+    switch (kind) {
+    case REORDER_DEGREE: {
+        // 차수 내림차순: 허브들이 앞쪽 연속 구간에 모인다
+        int* rank = degree_order(g);
+        for (int u = 0; u < n; ++u) order[n - 1 - rank[u]] = u;
+        free(rank);
+        break;
+    }
+    case REORDER_RCM:
+        bfs_order(g, true, order);
+        for (int i = 0; i < n / 2; ++i) { int t = order[i]; order[i] = order[n - 1 - i]; order[n - 1 - i] = t; }
+        break;
+    case REORDER_BFS:
+        bfs_order(g, false, order);
+        break;
+    }
+    return vmap_from_order(order, n);
+}
+
+// 평균 이웃 번호 간격(작을수록 지역성이 좋다)
+static double csr_avg_gap(const CsrGraph* g) {
+    double sum = 0.0;
+    for (int u = 0; u < g->n; ++u)
+        for (uint64_t i = g->off[u]; i < g->off[u + 1]; ++i) sum += abs(g->adj[i] - u);
+    return g->m ? sum / (double)g->m : 0.0;
+}
+
+// ========================= 벤치마크 루틴 =========================
+
+typedef struct {
+    const char* name;
+    size_t memBytes;
+    long long cmp_ins_del;
+    long long cmp_conn;
+    long long cmp_nei;
+} Report;
+
+void benchmark_am(const char* name, int n, Edge* baseEdges, int m, Report* rep) {
+    Counters c; resetCounters(&c);
+    AdjMatrix* g = build_am_from_edges(n, baseEdges, m, &c);
+
+    // 메모리 측정
+    rep->name = name;
+    rep->memBytes = am_memory_bytes(g);
+
+    // 테스트 연산:
+    // 1) 임의 간선 100개 삽입 시도(절반은 존재할 수도, 없을 수도)
+    // 2) 임의 간선 100개 삭제 시도
+    // 3) 연결 여부 확인 1000회
+    // 4) 임의 정점 100개에 대해 인접 노드 나열
+    int trials_ins = 100, trials_del = 100, trials_conn = 1000, trials_nei = 100;
+
+    // 삽입 테스트
+    for (int i = 0; i < trials_ins; ++i) {
+        int u = rand() % n, v = rand() % n;
+        if (u == v) { v = (v + 1) % n; }
+        am_insert_edge(g, u, v, &c);
+    }
+    // 삭제 테스트
+    for (int i = 0; i < trials_del; ++i) {
+        int u = rand() % n, v = rand() % n;
+        if (u == v) { v = (v + 1) % n; }
         am_delete_edge(g, u, v, &c);
     }
     // 연결 여부 테스트
@@ -355,8 +2125,572 @@ void benchmark_al(const char* name, int n, Edge* baseEdges, int m, Report* rep)
     al_free(g);
 }
 
-// ========================= 메인: 4 케이스 실행 =========================
-int main(void) {
+void benchmark_bm(const char* name, int n, Edge* baseEdges, int m, Report* rep) {
+    Counters c; resetCounters(&c);
+    BitMatrix* g = build_bm_from_edges(n, baseEdges, m, &c);
+
+    // 메모리 측정
+    rep->name = name;
+    rep->memBytes = bm_memory_bytes(g);
+
+    int trials_ins = 100, trials_del = 100, trials_conn = 1000, trials_nei = 100;
+
+    // 삽입 테스트
+    for (int i = 0; i < trials_ins; ++i) {
+        int u = rand() % n, v = rand() % n;
+        if (u == v) { v = (v + 1) % n; }
+        bm_insert_edge(g, u, v, &c);
+    }
+    // 삭제 테스트
+    for (int i = 0; i < trials_del; ++i) {
+        int u = rand() % n, v = rand() % n;
+        if (u == v) { v = (v + 1) % n; }
+        bm_delete_edge(g, u, v, &c);
+    }
+    // 연결 여부 테스트
+    for (int i = 0; i < trials_conn; ++i) {
+        int u = rand() % n, v = rand() % n;
+        if (u == v) { v = (v + 1) % n; }
+        (void)bm_has_edge(g, u, v, &c);
+    }
+    // 인접 노드 출력 테스트
+    int buf[1000];
+    for (int i = 0; i < trials_nei; ++i) {
+        int u = rand() % n;
+        (void)bm_neighbors(g, u, buf, 1000, &c);
+    }
+
+    rep->cmp_ins_del = c.cmp_insert_delete;
+    rep->cmp_conn = c.cmp_connected;
+    rep->cmp_nei = c.cmp_neighbors;
+
+    bm_free(g);
+}
+
+// ========================= 추가 실행 모드 =========================
+
+// 명령행의 생성기 이름으로 간선 목록 생성(gen/build 등 공용)
+// n == 1이면 R-MAT/멱법칙의 자기 루프 재추출이 끝나지 않으므로 여기서 막는다.
+static bool generate_by_name(const char* kind, int n, size_t m, uint64_t seed, EdgeList* out) {
+    if (n < 2 || m == 0) {
+        fprintf(stderr, "[ERR] %s: 정점 수 n >= 2, 간선 수 m >= 1 이어야 합니다 (n=%d, m=%zu)\n", kind, n, m);
+        return false;
+    }
+    if (strcmp(kind, "er") == 0) *out = gen_erdos_renyi(n, m, seed);
+    else if (strcmp(kind, "rmat") == 0) *out = gen_rmat(n, m, 0.57, 0.19, 0.19, seed);
+    else if (strcmp(kind, "plaw") == 0) *out = gen_power_law(n, m, 2.5, seed);
+    else {
+        fprintf(stderr, "알 수 없는 생성기: %s\n", kind);
+        return false;
+    }
+    return true;
+}
+
+// hw06 gen <er|rmat|plaw> <n> <m> [seed]
+static int run_gen(int argc, char** argv) {
+    if (argc < 5) {
+        fprintf(stderr, "사용법: %s gen <er|rmat|plaw> <n> <m> [seed]\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[3]);
+    size_t m = (size_t)strtoull(argv[4], NULL, 10);
+    uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : (uint64_t)time(NULL);
+    double t0 = now_sec();
+    EdgeList L;
+    if (!generate_by_name(argv[2], n, m, seed, &L)) return 1;
+    double t1 = now_sec();
+    printf("생성기 %s: 정점 %d, 간선 %zu, %.3f초 (스레드 %d)\n", argv[2], n, L.m, t1 - t0, thread_count());
+    el_free(&L);
+    return 0;
+}
+
+// hw06 build <er|rmat|plaw> <n> <m> [seed]
+// 병렬 CSR 빌더와 기존 간선별 삽입 빌더의 구축 시간 비교
+static int run_build(int argc, char** argv) {
+    if (argc < 5) {
+        fprintf(stderr, "사용법: %s build <er|rmat|plaw> <n> <m> [seed]\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[3]);
+    size_t m = (size_t)strtoull(argv[4], NULL, 10);
+    uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : (uint64_t)time(NULL);
+    EdgeList L;
+    if (!generate_by_name(argv[2], n, m, seed, &L)) return 1;
+
+    double t0 = now_sec();
+    CsrGraph* csr = build_csr_from_edges(n, L.e, L.m);
+    double t1 = now_sec();
+    AdjList* al = build_al_from_csr(csr);
+    double t2 = now_sec();
+    printf("입력 간선 %zu, 중복 제거 후 무방향 간선 %zu (스레드 %d)\n", L.m, csr->m / 2, thread_count());
+    printf("CSR 병렬 구축          : %.3f초, 메모리 %zu Bytes\n", t1 - t0, csr_memory_bytes(csr));
+    printf("CSR -> 인접리스트 변환 : %.3f초, 메모리 %zu Bytes\n", t2 - t1, al_memory_bytes(al));
+    al_free(al);
+    csr_free(csr);
+
+    // 기존 빌더는 O(m * 차수)이므로 작은 입력에서만 비교
+    if (L.m <= 200000) {
+        Counters c; resetCounters(&c);
+        double t3 = now_sec();
+        AdjList* slow = build_al_from_edges(n, L.e, (int)L.m, &c);
+        double t4 = now_sec();
+        printf("기존 간선별 삽입 빌더  : %.3f초, 비교 %lld번\n", t4 - t3, c.cmp_insert_delete);
+        al_free(slow);
+    }
+    el_free(&L);
+    return 0;
+}
+
+// hw06 bfs <er|rmat|plaw> <n> <m> [seed]
+// 각 백엔드에서 BFS/연결 요소를 돌려 결과 일치와 시간을 확인
+static int run_bfs(int argc, char** argv) {
+    if (argc < 5) {
+        fprintf(stderr, "사용법: %s bfs <er|rmat|plaw> <n> <m> [seed]\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[3]);
+    size_t m = (size_t)strtoull(argv[4], NULL, 10);
+    uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : (uint64_t)time(NULL);
+    EdgeList L;
+    if (!generate_by_name(argv[2], n, m, seed, &L)) return 1;
+    CsrGraph* csr = build_csr_from_edges(n, L.e, L.m);
+    AdjList* al = build_al_from_csr(csr);
+    // 행렬 백엔드는 n^2 메모리이므로 작은 그래프에서만
+    BitMatrix* bm = NULL;
+    AdjMatrix* am = NULL;
+    if (n <= 50000) {
+        Counters c; resetCounters(&c);
+        bm = bm_create(n);
+        for (size_t i = 0; i < L.m; ++i) if (L.e[i].u != L.e[i].v) bm_insert_edge(bm, L.e[i].u, L.e[i].v, &c);
+    }
+    if (n <= 10000) {
+        Counters c; resetCounters(&c);
+        am = build_am_from_edges(n, L.e, (int)L.m, &c);
+    }
+    el_free(&L);
+
+    GraphView views[4];
+    const char* names[4];
+    int nv = 0;
+    views[nv] = gv_csr(csr); names[nv++] = "CSR";
+    views[nv] = gv_list(al); names[nv++] = "인접리스트";
+    if (bm) { views[nv] = gv_bitmatrix(bm); names[nv++] = "비트행렬"; }
+    if (am) { views[nv] = gv_matrix(am); names[nv++] = "인접행렬"; }
+
+    int* parent = (int*)malloc((size_t)n * sizeof(int));
+    int* depth = (int*)malloc((size_t)n * sizeof(int));
+    int* depth0 = (int*)malloc((size_t)n * sizeof(int));
+    int* label = (int*)malloc((size_t)n * sizeof(int));
+    printf("정점 %d, 무방향 간선 %zu, 스레드 %d\n", n, csr->m / 2, thread_count());
+    for (int i = 0; i < nv; ++i) {
+        BfsStats st;
+        double t0 = now_sec();
+        int reached = bfs_direction_optimizing(&views[i], 0, parent, depth, &st);
+        double t1 = now_sec();
+        int comps = connected_components(&views[i], label);
+        double t2 = now_sec();
+        bool same = true;
+        if (i == 0) memcpy(depth0, depth, (size_t)n * sizeof(int));
+        else same = memcmp(depth0, depth, (size_t)n * sizeof(int)) == 0;
+        printf("%-10s BFS %.3f초 (도달 %d, top-down %d단계, bottom-up %d단계)%s, 연결 요소 %d개 %.3f초\n",
+               names[i], t1 - t0, reached, st.td_steps, st.bu_steps, same ? "" : " [깊이 불일치]",
+               comps, t2 - t1);
+    }
+    free(parent); free(depth); free(depth0); free(label);
+    am_free(am); bm_free(bm); al_free(al); csr_free(csr);
+    return 0;
+}
+
+// hw06 tri <er|rmat|plaw> <n> <m> [seed]
+// 삼각형 수(병합 전용 vs 병합+비트셋)와 공통 이웃/Jaccard 질의 시간
+static int run_tri(int argc, char** argv) {
+    if (argc < 5) {
+        fprintf(stderr, "사용법: %s tri <er|rmat|plaw> <n> <m> [seed]\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[3]);
+    size_t m = (size_t)strtoull(argv[4], NULL, 10);
+    uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : (uint64_t)time(NULL);
+    EdgeList L;
+    if (!generate_by_name(argv[2], n, m, seed, &L)) return 1;
+    CsrGraph* g = build_csr_from_edges(n, L.e, L.m);
+    el_free(&L);
+    printf("정점 %d, 무방향 간선 %zu, 스레드 %d\n", n, g->m / 2, thread_count());
+
+    double t0 = now_sec();
+    long long t_merge = count_triangles(g, false);
+    double t1 = now_sec();
+    long long t_hybrid = count_triangles(g, true);
+    double t2 = now_sec();
+    printf("삼각형(병합)         : %lld개, %.3f초\n", t_merge, t1 - t0);
+    printf("삼각형(병합+비트셋)  : %lld개, %.3f초%s\n", t_hybrid, t2 - t1, t_merge == t_hybrid ? "" : " [불일치]");
+
+    // 공통 이웃 질의: 간선 양 끝점 쌍(공통 이웃이 있을 법한 쌍) 10만 개
+    int queries = 100000;
+    int* qu = (int*)malloc((size_t)queries * sizeof(int));
+    int* qv = (int*)malloc((size_t)queries * sizeof(int));
+    for (int i = 0; i < queries; ++i) {
+        int u = rand() % n;
+        int d = csr_degree(g, u);
+        qu[i] = u;
+        qv[i] = d ? g->adj[g->off[u] + (uint64_t)(rand() % d)] : (u + 1) % n;
+    }
+    double sumMerge = 0.0, sumBits = 0.0;
+    double t3 = now_sec();
+    for (int i = 0; i < queries; ++i) sumMerge += jaccard(g, NULL, qu[i], qv[i]);
+    double t4 = now_sec();
+    printf("Jaccard 질의 %d회(병합)    : %.3f초, 평균 %.4f\n", queries, t4 - t3, sumMerge / queries);
+    if (n <= 50000) {
+        Counters c; resetCounters(&c);
+        BitMatrix* bm = bm_create(n);
+        for (int u = 0; u < n; ++u)
+            for (uint64_t i = g->off[u]; i < g->off[u + 1]; ++i) bm_insert_edge(bm, u, g->adj[i], &c);
+        double t5 = now_sec();
+        for (int i = 0; i < queries; ++i) sumBits += jaccard(g, bm, qu[i], qv[i]);
+        double t6 = now_sec();
+        printf("Jaccard 질의 %d회(혼합)    : %.3f초, 평균 %.4f\n", queries, t6 - t5, sumBits / queries);
+        bm_free(bm);
+    }
+    free(qu); free(qv);
+    csr_free(g);
+    return 0;
+}
+
+// hw06 save <er|rmat|plaw> <n> <m> <file> [seed]
+static int run_save(int argc, char** argv) {
+    if (argc < 6) {
+        fprintf(stderr, "사용법: %s save <er|rmat|plaw> <n> <m> <file> [seed]\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[3]);
+    size_t m = (size_t)strtoull(argv[4], NULL, 10);
+    uint64_t seed = argc > 6 ? strtoull(argv[6], NULL, 10) : (uint64_t)time(NULL);
+    EdgeList L;
+    if (!generate_by_name(argv[2], n, m, seed, &L)) return 1;
+    CsrGraph* g = build_csr_from_edges(n, L.e, L.m);
+    el_free(&L);
+    GraphView G = gv_csr(g);
+    double t0 = now_sec();
+    bool ok = gv_save(&G, argv[5]);
+    double t1 = now_sec();
+    if (ok) printf("%s 저장: 정점 %d, 방향 간선 %zu, %.3f초\n", argv[5], n, g->m, t1 - t0);
+    csr_free(g);
+    return ok ? 0 : 1;
+}
+
+// hw06 load <file> [verify]: 매핑 시간과 매핑된 CSR 위에서의 BFS/연결 요소.
+// verify를 주면 이웃 번호 범위 검사(O(m))를 하고 그 시간을 따로 보인다.
+static int run_load(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "사용법: %s load <file> [verify]\n", argv[0]);
+        return 1;
+    }
+    bool verify = argc > 3 && strcmp(argv[3], "verify") == 0;
+    GraphFile gf;
+    CsrGraph g;
+    double t0 = now_sec();
+    if (!gf_open(argv[2], &gf)) return 1;
+    if (!csr_view_of_file(&gf, &g, false)) {
+        gf_close(&gf);
+        return 1;
+    }
+    double t1 = now_sec();
+    printf("%s 매핑: 정점 %d, 방향 간선 %zu, %.6f초\n", argv[2], g.n, g.m, t1 - t0);
+    if (verify) {
+        if (!csr_view_of_file(&gf, &g, true)) {
+            gf_close(&gf);
+            return 1;
+        }
+        printf("이웃 번호 검사: %.6f초\n", now_sec() - t1);
+    }
+    GraphView G = gv_csr(&g);
+    if (g.n > 0) {
+        int* parent = (int*)malloc((size_t)g.n * sizeof(int));
+        int* depth = (int*)malloc((size_t)g.n * sizeof(int));
+        double t2 = now_sec();
+        int reached = bfs_direction_optimizing(&G, 0, parent, depth, NULL);
+        double t3 = now_sec();
+        int comps = connected_components(&G, parent);
+        double t4 = now_sec();
+        printf("BFS 도달 %d (%.3f초), 연결 요소 %d개 (%.3f초)\n", reached, t3 - t2, comps, t4 - t3);
+        free(parent); free(depth);
+    }
+    gf_close(&gf);
+    return 0;
+}
+
+// hw06 pma <er|rmat|plaw> <n> <m> [batch] [seed]
+// 간선을 배치로 모두 삽입한 뒤 앞쪽 절반을 배치로 삭제. 처리량과 스캔 속도, CSR과의 일치 확인
+static int run_pma(int argc, char** argv) {
+    if (argc < 5) {
+        fprintf(stderr, "사용법: %s pma <er|rmat|plaw> <n> <m> [batch] [seed]\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[3]);
+    size_t m = (size_t)strtoull(argv[4], NULL, 10);
+    size_t batch = argc > 5 ? (size_t)strtoull(argv[5], NULL, 10) : 10000;
+    uint64_t seed = argc > 6 ? strtoull(argv[6], NULL, 10) : (uint64_t)time(NULL);
+    if (batch == 0) batch = 1;
+    EdgeList L;
+    if (!generate_by_name(argv[2], n, m, seed, &L)) return 1;
+
+    PmaGraph* g = pma_create(n);
+    PmaUpdate* ups = (PmaUpdate*)malloc(batch * sizeof(PmaUpdate));
+    double t0 = now_sec();
+    for (size_t i = 0; i < L.m; i += batch) {
+        size_t k = L.m - i < batch ? L.m - i : batch;
+        for (size_t j = 0; j < k; ++j) { ups[j].u = L.e[i + j].u; ups[j].v = L.e[i + j].v; ups[j].insert = true; }
+        pma_apply_batch(g, ups, k);
+    }
+    double t1 = now_sec();
+    size_t half = L.m / 2;
+    for (size_t i = 0; i < half; i += batch) {
+        size_t k = half - i < batch ? half - i : batch;
+        for (size_t j = 0; j < k; ++j) { ups[j].u = L.e[i + j].u; ups[j].v = L.e[i + j].v; ups[j].insert = false; }
+        pma_apply_batch(g, ups, k);
+    }
+    double t2 = now_sec();
+    printf("배치 %zu: 삽입 %.2f M건/초, 삭제 %.2f M건/초, 슬롯 %zu (밀도 %.2f), 메모리 %zu Bytes\n",
+           batch, L.m / (t1 - t0 + 1e-9) / 1e6, half / (t2 - t1 + 1e-9) / 1e6,
+           g->cap, (double)g->count / g->cap, pma_memory_bytes(g));
+
+    // 남은 간선(뒤쪽 절반 중 앞쪽 절반과 겹치지 않는 것)과 비교
+    CsrGraph* ref = build_csr_from_edges(n, L.e + half, L.m - half);
+    CsrGraph* del = build_csr_from_edges(n, L.e, half);
+    Counters c; resetCounters(&c);
+    size_t expect = 0, bad = 0;
+    for (int u = 0; u < n; ++u)
+        for (uint64_t i = ref->off[u]; i < ref->off[u + 1]; ++i) {
+            if (csr_has_edge(del, u, ref->adj[i], &c)) continue;
+            expect++;
+            if (!pma_has_edge(g, u, ref->adj[i], &c)) bad++;
+        }
+    printf("검증: 기대 방향 간선 %zu, PMA %zu, 누락 %zu\n", expect, g->count, bad);
+
+    int* buf = (int*)malloc((size_t)n * sizeof(int));
+    long long sink = 0;
+    double t3 = now_sec();
+    for (int u = 0; u < n; ++u) sink += pma_neighbors(g, u, buf, n, &c);
+    double t4 = now_sec();
+    for (int u = 0; u < n; ++u) sink += csr_neighbors(ref, u, buf, n, &c);
+    double t5 = now_sec();
+    printf("전체 이웃 스캔: PMA %.3f초, CSR %.3f초 (%lld)\n", t4 - t3, t5 - t4, sink);
+
+    free(buf); free(ups);
+    csr_free(ref); csr_free(del); pma_free(g); el_free(&L);
+    return 0;
+}
+
+// hw06 reorder <er|rmat|plaw> <n> <m> [seed]
+// 번호를 무작위로 섞은 그래프와 각 재배치 결과에서 BFS(비가중 최단경로)/연결 요소 시간 비교
+static int run_reorder(int argc, char** argv) {
+    if (argc < 5) {
+        fprintf(stderr, "사용법: %s reorder <er|rmat|plaw> <n> <m> [seed]\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[3]);
+    size_t m = (size_t)strtoull(argv[4], NULL, 10);
+    uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : (uint64_t)time(NULL);
+    EdgeList L;
+    if (!generate_by_name(argv[2], n, m, seed, &L)) return 1;
+    CsrGraph* g0 = build_csr_from_edges(n, L.e, L.m);
+    el_free(&L);
+
+    // 기준선: 무작위 번호(피셔-예이츠 셔플)
+    int* shuffle = (int*)malloc((size_t)n * sizeof(int));
+    Rng r; rng_seed(&r, seed, 0xC0FFEE);
+    for (int i = 0; i < n; ++i) shuffle[i] = i;
+    for (int i = n - 1; i > 0; --i) {
+        int j = (int)(rng_next(&r) % (uint64_t)(i + 1));
+        int t = shuffle[i]; shuffle[i] = shuffle[j]; shuffle[j] = t;
+    }
+    CsrGraph* base = csr_relabel(g0, shuffle);
+    csr_free(g0);
+    free(shuffle);
+
+    const int sources = 8;
+    int src[8];
+    for (int i = 0; i < sources; ++i) src[i] = (int)(rng_next(&r) % (uint64_t)n);
+    int* parent = (int*)malloc((size_t)n * sizeof(int));
+    int* depth = (int*)malloc((size_t)n * sizeof(int));
+
+    const char* names[4] = { "무작위(기준)", "차수 정렬", "RCM", "BFS 순서" };
+    long long reachedBase = -1;
+    printf("정점 %d, 무방향 간선 %zu, 스레드 %d\n", n, base->m / 2, thread_count());
+    for (int k = 0; k < 4; ++k) {
+        VertexMap mp = { 0, NULL, NULL };
+        CsrGraph* g = base;
+        double tr = 0.0;
+        if (k > 0) {
+            double t0 = now_sec();
+            mp = reorder_compute(base, (ReorderKind)(k - 1));
+            g = csr_relabel(base, mp.newOf);
+            tr = now_sec() - t0;
+        }
+        GraphView G = gv_csr(g);
+        long long reached = 0;
+        double t1 = now_sec();
+        for (int i = 0; i < sources; ++i) {
+            int s = k > 0 ? vmap_to_internal(&mp, src[i]) : src[i];
+            reached += bfs_direction_optimizing(&G, s, parent, depth, NULL);
+        }
+        double t2 = now_sec();
+        int comps = connected_components(&G, parent);
+        double t3 = now_sec();
+        if (reachedBase < 0) reachedBase = reached;
+        printf("%-12s 재배치 %.3f초, 평균 이웃 간격 %.0f, BFS %d회 %.3f초, 연결 요소 %d개 %.3f초%s\n",
+               names[k], tr, csr_avg_gap(g), sources, t2 - t1, comps, t3 - t2,
+               reached == reachedBase ? "" : " [도달 수 불일치]");
+        if (k > 0) {
+            csr_free(g);
+            vmap_free(&mp);
+        }
+    }
+    free(parent); free(depth);
+    csr_free(base);
+    return 0;
+}
+
+// hw06 conc <er|rmat|plaw> <n> <m> [seed]
+// 1..최대 스레드에서 동시 삽입 후 (조회 3 : 삭제 1) 혼합 처리량 측정
+static int run_conc(int argc, char** argv) {
+    if (argc < 5) {
+        fprintf(stderr, "사용법: %s conc <er|rmat|plaw> <n> <m> [seed]\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[3]);
+    size_t m = (size_t)strtoull(argv[4], NULL, 10);
+    uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : (uint64_t)time(NULL);
+    EdgeList L;
+    if (!generate_by_name(argv[2], n, m, seed, &L)) return 1;
+    CsrGraph* ref = build_csr_from_edges(n, L.e, L.m);
+    int maxT = thread_count();
+    printf("정점 %d, 입력 간선 %zu (고유 %zu)\n", n, L.m, ref->m / 2);
+
+    double base = 0.0;
+    // 1, 2, 4, ... 로 두 배씩 늘리되 마지막은 maxT(홀수여도 끝난다)
+    for (int T = 1; T <= maxT; T = T * 2 > maxT ? maxT : T * 2) {
+        ConcAdjList* cg = cal_create(n, 64 * maxT);
+        double t0 = now_sec();
+        #pragma omp parallel for num_threads(T) schedule(static)
+        for (long long i = 0; i < (long long)L.m; ++i) {
+            Counters c; resetCounters(&c);
+            cal_insert_edge(cg, L.e[i].u, L.e[i].v, &c);
+        }
+        double t1 = now_sec();
+        size_t directed = 0;
+        for (int u = 0; u < n; ++u) {
+            Counters c; resetCounters(&c);
+            directed += (size_t)al_neighbors(cg->g, u, NULL, 0, &c);
+        }
+        long long found = 0;
+        #pragma omp parallel for num_threads(T) schedule(static) reduction(+:found)
+        for (long long i = 0; i < (long long)L.m; ++i) {
+            Counters c; resetCounters(&c);
+            if (i % 4 == 3) cal_delete_edge(cg, L.e[i].u, L.e[i].v, &c);
+            else found += cal_has_edge(cg, L.e[i].v, L.e[i].u, &c);
+        }
+        double t2 = now_sec();
+        double rate = L.m / (t1 - t0 + 1e-9) / 1e6;
+        if (T == 1) base = rate;
+        printf("스레드 %2d: 삽입 %.2f M건/초 (x%.2f), 혼합 %.2f M건/초, 방향 간선 %zu%s\n",
+               T, rate, rate / base, L.m / (t2 - t1 + 1e-9) / 1e6, directed,
+               directed == ref->m ? "" : " [불일치]");
+        cal_free(cg);
+        if (T == maxT) break;
+    }
+    csr_free(ref);
+    el_free(&L);
+    return 0;
+}
+
+// hw06 pr <er|rmat|plaw> <n> <m> [seed]
+// 백엔드/모드별 PageRank 반복당 시간과 수렴, CSR pull(double) 대비 최대 오차
+static int run_pagerank(int argc, char** argv) {
+    if (argc < 5) {
+        fprintf(stderr, "사용법: %s pr <er|rmat|plaw> <n> <m> [seed]\n", argv[0]);
+        return 1;
+    }
+    int n = atoi(argv[3]);
+    size_t m = (size_t)strtoull(argv[4], NULL, 10);
+    uint64_t seed = argc > 5 ? strtoull(argv[5], NULL, 10) : (uint64_t)time(NULL);
+    EdgeList L;
+    if (!generate_by_name(argv[2], n, m, seed, &L)) return 1;
+    CsrGraph* csr = build_csr_from_edges(n, L.e, L.m);
+    AdjList* al = build_al_from_csr(csr);
+    // 행렬 백엔드는 n^2 메모리이므로 작은 그래프에서만(run_bfs와 같은 기준)
+    BitMatrix* bm = NULL;
+    AdjMatrix* am = NULL;
+    if (n <= 50000) {
+        Counters c; resetCounters(&c);
+        bm = bm_create(n);
+        for (size_t i = 0; i < L.m; ++i) if (L.e[i].u != L.e[i].v) bm_insert_edge(bm, L.e[i].u, L.e[i].v, &c);
+    }
+    if (n <= 10000) {
+        Counters c; resetCounters(&c);
+        am = build_am_from_edges(n, L.e, (int)L.m, &c);
+    }
+    // PMA는 전체 간선을 한 배치로 넣는다(큰 배치는 한 번의 병합 재배치)
+    PmaGraph* pma = pma_create(n);
+    PmaUpdate* ups = (PmaUpdate*)malloc((L.m ? L.m : 1) * sizeof(PmaUpdate));
+    if (!ups) { perror("malloc"); exit(1); }
+    for (size_t i = 0; i < L.m; ++i) { ups[i].u = L.e[i].u; ups[i].v = L.e[i].v; ups[i].insert = true; }
+    pma_apply_batch(pma, ups, L.m);
+    free(ups);
+    el_free(&L);
+
+    struct { const char* name; GraphView G; PrMode mode; bool f32; } runs[7];
+    int nr = 0;
+    runs[nr].name = "CSR pull double"; runs[nr].G = gv_csr(csr); runs[nr].mode = PR_PULL; runs[nr].f32 = false; nr++;
+    runs[nr].name = "CSR pull float32"; runs[nr].G = gv_csr(csr); runs[nr].mode = PR_PULL; runs[nr].f32 = true; nr++;
+    runs[nr].name = "CSR push double"; runs[nr].G = gv_csr(csr); runs[nr].mode = PR_PUSH; runs[nr].f32 = false; nr++;
+    runs[nr].name = "리스트 pull"; runs[nr].G = gv_list(al); runs[nr].mode = PR_PULL; runs[nr].f32 = false; nr++;
+    runs[nr].name = "PMA pull"; runs[nr].G = gv_pma(pma); runs[nr].mode = PR_PULL; runs[nr].f32 = false; nr++;
+    if (bm) { runs[nr].name = "비트행렬 pull"; runs[nr].G = gv_bitmatrix(bm); runs[nr].mode = PR_PULL; runs[nr].f32 = false; nr++; }
+    if (am) { runs[nr].name = "행렬 pull"; runs[nr].G = gv_matrix(am); runs[nr].mode = PR_PULL; runs[nr].f32 = false; nr++; }
+
+    const int maxIter = 100;
+    const double tol = 1e-7;
+    double* ref = (double*)malloc((size_t)n * sizeof(double));
+    double* rank = (double*)malloc((size_t)n * sizeof(double));
+    double hist[100];
+    printf("정점 %d, 무방향 간선 %zu, 스레드 %d, d=0.85, tol=%g\n", n, csr->m / 2, thread_count(), tol);
+    for (int i = 0; i < nr; ++i) {
+        PrStats st;
+        pagerank(&runs[i].G, runs[i].mode, runs[i].f32, 0.85, tol, maxIter, i == 0 ? ref : rank, hist, &st);
+        double err = 0.0;
+        if (i > 0)
+            for (int v = 0; v < n; ++v) err = fmax(err, fabs(rank[v] - ref[v]));
+        printf("%-18s 반복 %3d, 반복당 %.3fms, 마지막 변화량 %.2e, 기준 대비 최대 오차 %.2e\n",
+               runs[i].name, st.iters, st.seconds * 1000.0 / (st.iters ? st.iters : 1), st.delta, err);
+        if (i == 0) {
+            printf("  수렴: ");
+            for (int k = 0; k < st.iters; k += (st.iters + 7) / 8) printf("[%d] %.1e  ", k + 1, hist[k]);
+            printf("\n");
+        }
+    }
+    free(ref); free(rank);
+    pma_free(pma); am_free(am); bm_free(bm); al_free(al); csr_free(csr);
+    return 0;
+}
+
+// ========================= 메인: 6 케이스 실행 =========================
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        if (strcmp(argv[1], "gen") == 0) return run_gen(argc, argv);
+        if (strcmp(argv[1], "build") == 0) return run_build(argc, argv);
+        if (strcmp(argv[1], "bfs") == 0) return run_bfs(argc, argv);
+        if (strcmp(argv[1], "tri") == 0) return run_tri(argc, argv);
+        if (strcmp(argv[1], "save") == 0) return run_save(argc, argv);
+        if (strcmp(argv[1], "load") == 0) return run_load(argc, argv);
+        if (strcmp(argv[1], "pma") == 0) return run_pma(argc, argv);
+        if (strcmp(argv[1], "reorder") == 0) return run_reorder(argc, argv);
+        if (strcmp(argv[1], "conc") == 0) return run_conc(argc, argv);
+        if (strcmp(argv[1], "pr") == 0) return run_pagerank(argc, argv);
+        fprintf(stderr, "알 수 없는 모드: %s\n", argv[1]);
+        return 1;
+    }
+
     srand((unsigned)time(NULL));
 
     // 1) 희소 그래프(100간선) 생성용 에지 목록
@@ -369,15 +2703,17 @@ int main(void) {
     int md = 0;
     generate_random_edges(N_VERT, DENSE_EDGES, Ed, &md);
 
-    Report r1, r2, r3, r4;
+    Report r1, r2, r3, r4, r5, r6;
     benchmark_am("케이스 1: 희소그래프-인접행렬", N_VERT, Es, ms, &r1);
     benchmark_al("케이스 2: 희소그래프-인접리스트", N_VERT, Es, ms, &r2);
     benchmark_am("케이스 3: 밀집그래프-인접행렬", N_VERT, Ed, md, &r3);
     benchmark_al("케이스 4: 밀집그래프-인접리스트", N_VERT, Ed, md, &r4);
+    benchmark_bm("케이스 5: 희소그래프-비트행렬", N_VERT, Es, ms, &r5);
+    benchmark_bm("케이스 6: 밀집그래프-비트행렬", N_VERT, Ed, md, &r6);
 
     // 출력
-    Report reps[4] = { r1, r2, r3, r4 };
-    for (int i = 0; i < 4; ++i) {
+    Report reps[6] = { r1, r2, r3, r4, r5, r6 };
+    for (int i = 0; i < 6; ++i) {
         printf("%s\n", reps[i].name);
         printf("메모리 %zu Bytes\n", reps[i].memBytes);
         printf("간선 삽입/삭제 비교 %lld번\n", reps[i].cmp_ins_del);
@@ -3,9 +3,31 @@
 #include <time.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include "graph_file.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
-#define N 10          // 정점 수
-#define M 20          // 간선 수 (무방향 간선)
+// 빌드 예: gcc -O2 -fopenmp -mavx2 hw07.c -o hw07
+// (-fopenmp / -mavx2 없이도 단일 스레드·스칼라 경로로 동작)
+
+#define DEFAULT_N 10        // 기본 정점 수
+#define DEFAULT_M 20        // 기본 간선 수 (무방향 간선)
+#define DEFAULT_MAXW 10     // 기본 최대 가중치
+#define PRINT_LIMIT 20      // 정점 수가 이 이하일 때만 간선 목록/모든 쌍 경로 출력
+#define APSP_MATRIX_LIMIT (1ull << 30)  // 기본 모드에서 거리 행렬을 저장할 최대 바이트
+#define APSP_VERIFY 4       // 병렬 APSP 결과를 직렬 Dijkstra로 대조할 출발점 수
+#define FW_BLOCK 64         // Floyd-Warshall 타일 한 변(int 64개 = 256바이트 행, 타일 16KB)
+// APSP 비용 모델(n=2000, 1코어 AVX2 실측, ns): Dijkstra 출발점당 ≈ 방향 간선*ARC + 정점*VERT,
+// FW 출발점당 ≈ n*n*CELL. 스레드 수는 양쪽에 같이 곱해지므로 비교에서 빠진다.
+#define APSP_ARC_NS 2.8
+#define APSP_VERT_NS 70.0
+#define APSP_CELL_NS 0.25
 #define INF 0x3f3f3f3f
 
 // 디버그 로그 매크로
@@ -20,90 +42,308 @@ typedef struct Edge {
     struct Edge* next;
 } Edge;
 
+// 실행 시간에 크기를 정하는 그래프(정점별 인접 리스트)
 typedef struct {
-    Edge* head;
+    int n;          // 정점 수
+    int m;          // 무방향 간선 수
+    int maxW;       // 최대 간선 가중치(버킷 큐 크기 결정)
+    Edge** head;    // 크기 n
+    Edge* pool;     // compactGraph 이후 모든 간선을 담은 연속 블록(없으면 NULL)
 } Graph;
 
 typedef struct {
-    int dist[N];
-    int parent[N];
+    int n;
+    int* dist;      // 크기 n
+    int* parent;    // 크기 n
 } DijkstraResult;
 
+// 우선순위 큐 종류(실행 시 선택)
+typedef enum {
+    PQ_ARRAY,       // 배열 선형 탐색, O(N^2 + E)
+    PQ_BINARY,      // 위치 색인 이진 힙(decrease-key), O((N + E) log N)
+    PQ_PAIRING,     // 페어링 힙(decrease-key), 분할상환 O(E + N log N)에 가까움
+    PQ_DIAL,        // Dial 버킷 큐(원형 버킷 maxW+1개), O(N + E + 최대거리)
+    PQ_RADIX        // 라딕스 힙(단조 정수 키), O(E + N log C)
+} PqKind;
+
+static const char* pqName(PqKind k) {
+    switch (k) {
+    case PQ_ARRAY:   return "array";
+    case PQ_BINARY:  return "binary";
+    case PQ_PAIRING: return "pairing";
+    case PQ_DIAL:    return "dial";
+    case PQ_RADIX:   return "radix";
+    }
+    return "?";
+}
+
+static bool parsePq(const char* s, PqKind* out) {
+    if (strcmp(s, "array") == 0) *out = PQ_ARRAY;
+    else if (strcmp(s, "binary") == 0) *out = PQ_BINARY;
+    else if (strcmp(s, "pairing") == 0) *out = PQ_PAIRING;
+    else if (strcmp(s, "dial") == 0) *out = PQ_DIAL;
+    else if (strcmp(s, "radix") == 0) *out = PQ_RADIX;
+    else return false;
+    return true;
+}
+
+// 모드별 기본 큐: 가중치가 작으면(원형 버킷 maxW+1개가 감당할 만하면) Dial, 아니면 이진 힙
+static PqKind defaultPq(const Graph* g) {
+    return g->maxW <= (1 << 16) ? PQ_DIAL : PQ_BINARY;
+}
+
+// 고속 RNG: xorshift64 (rand()는 플랫폼에 따라 RAND_MAX가 32767이라 큰 그래프에 부족)
+static uint64_t rng_state = 88172645463325252ull;
+
+static inline uint64_t xorshift64(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static inline int randBelow(int n) { return (int)(xorshift64(&rng_state) % (uint64_t)n); }
+
+static void seedRng(uint64_t seed) {
+    rng_state = seed ? seed : 88172645463325252ull;
+    for (int i = 0; i < 8; ++i) xorshift64(&rng_state);
+}
+
+// 스레드/시간 유틸 (OpenMP 없으면 단일 스레드)
+static inline int thread_count(void) {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+static inline int thread_id(void) {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+static inline void set_thread_count(int t) {
+#ifdef _OPENMP
+    omp_set_num_threads(t);
+#else
+    (void)t;
+#endif
+}
+
+static inline double now_sec(void) {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+static bool isNumber(const char* s) {
+    if (!*s) return false;
+    for (; *s; ++s)
+        if (!isdigit((unsigned char)*s)) return false;
+    return true;
+}
+
 // 그래프 초기화/해제
-void initGraph(Graph* g) {
-    for (int i = 0; i < N; ++i) g[i].head = NULL;
+void initGraph(Graph* g, int n) {
+    g->n = n;
+    g->m = 0;
+    g->maxW = 0;
+    g->pool = NULL;
+    g->head = (Edge**)calloc((size_t)n, sizeof(Edge*));
+    if (!g->head) { perror("calloc"); exit(1); }
 }
 
 void freeGraph(Graph* g) {
-    for (int i = 0; i < N; ++i) {
-        Edge* cur = g[i].head;
-        // 방어적 해제: 최대 안전 카운트(노드 수 상한)로 루프 보호
-        int guard = 10000;
+    for (int i = 0; i < g->n && !g->pool; ++i) {
+        Edge* cur = g->head[i];
+        // 방어적 해제: 최대 안전 카운트(정점 수 상한)로 루프 보호
+        int guard = g->n;
         while (cur && guard-- > 0) {
             Edge* nx = cur->next;
             free(cur);
             cur = nx;
         }
-        g[i].head = NULL;
+        g->head[i] = NULL;
     }
+    free(g->head);
+    free(g->pool);
+    g->head = NULL;
+    g->pool = NULL;
+    g->n = g->m = g->maxW = 0;
+}
+
+// 결과 배열 할당/해제
+void initResult(DijkstraResult* r, int n) {
+    r->n = n;
+    r->dist = (int*)malloc((size_t)n * sizeof(int));
+    r->parent = (int*)malloc((size_t)n * sizeof(int));
+    if (!r->dist || !r->parent) { perror("malloc"); exit(1); }
+}
+
+void freeResult(DijkstraResult* r) {
+    free(r->dist);
+    free(r->parent);
+    r->dist = r->parent = NULL;
 }
 
 // 범위 체크 유틸
-static inline bool validV(int v) { return v >= 0 && v < N; }
+static inline bool validV(const Graph* g, int v) { return v >= 0 && v < g->n; }
+
+// u의 리스트에 v가 있는지(차수만큼 선형 탐색)
+static bool hasEdge(const Graph* g, int u, int v) {
+    for (const Edge* e = g->head[u]; e; e = e->next)
+        if (e->to == v) return true;
+    return false;
+}
+
+// u-v 간선 노드(u의 리스트 쪽) 찾기
+static Edge* findEdge(const Graph* g, int u, int v) {
+    for (Edge* e = g->head[u]; e; e = e->next)
+        if (e->to == v) return e;
+    return NULL;
+}
+
+// 무방향 간선 가중치 변경(양쪽 노드 모두). 간선이 없으면 false.
+bool setEdgeWeight(Graph* g, int u, int v, int w) {
+    Edge* a = findEdge(g, u, v);
+    Edge* b = findEdge(g, v, u);
+    if (!a || !b) return false;
+    a->w = w;
+    b->w = w;
+    if (w > g->maxW) g->maxW = w;
+    return true;
+}
+
+static void unlinkEdge(Graph* g, int u, int v) {
+    for (Edge** pp = &g->head[u]; *pp; pp = &(*pp)->next) {
+        if ((*pp)->to == v) {
+            Edge* e = *pp;
+            *pp = e->next;
+            if (!g->pool) free(e);  // 풀 안의 노드는 리스트에서만 뺀다
+            return;
+        }
+    }
+}
+
+// 무방향 간선 삭제. maxW는 상한으로만 쓰이므로 줄이지 않는다. 간선이 없으면 false.
+bool removeEdge(Graph* g, int u, int v) {
+    if (!validV(g, u) || !validV(g, v) || !hasEdge(g, u, v)) return false;
+    unlinkEdge(g, u, v);
+    unlinkEdge(g, v, u);
+    g->m--;
+    return true;
+}
 
 // 안전한 에지 추가
 void addEdge(Graph* g, int u, int v, int w) {
-    if (!validV(u) || !validV(v)) {
+    if (!validV(g, u) || !validV(g, v)) {
         fprintf(stderr, "[ERR] addEdge 범위 오류 u=%d v=%d\n", u, v);
         exit(1);
     }
+    if (g->pool) {
+        fprintf(stderr, "[ERR] compactGraph 이후에는 간선을 추가할 수 없습니다\n");
+        exit(1);
+    }
     DLOG("[DEBUG] addEdge: u=%d, v=%d, w=%d\n", u, v, w);
     // u -> v
     Edge* e1 = (Edge*)malloc(sizeof(Edge));
     if (!e1) { perror("malloc"); exit(1); }
-    e1->to = v; e1->w = w; e1->next = g[u].head; g[u].head = e1;
+    e1->to = v; e1->w = w; e1->next = g->head[u]; g->head[u] = e1;
 
     // v -> u (무방향)
     Edge* e2 = (Edge*)malloc(sizeof(Edge));
     if (!e2) { perror("malloc"); exit(1); }
-    e2->to = u; e2->w = w; e2->next = g[v].head; g[v].head = e2;
+    e2->to = u; e2->w = w; e2->next = g->head[v]; g->head[v] = e2;
+    g->m++;
+    if (w > g->maxW) g->maxW = w;
 }
 
-// 무작위 간선 생성 (무방향, 중복/루프 금지), 가중치 1~10
-void generateRandomGraph(Graph* g) {
-    int used[N][N] = {0};
+// 무작위 간선 생성 (무방향, 중복/루프 금지), 가중치 1~maxW
+// 중복은 u의 인접 리스트를 훑어 확인하므로 추가 메모리는 O(m).
+void generateRandomGraph(Graph* g, int m, int maxW) {
+    int n = g->n;
+    if (n < 2 || (long long)m > (long long)n * (n - 1) / 2) {
+        fprintf(stderr, "[ERR] 간선 수가 너무 많습니다: n=%d m=%d\n", n, m);
+        exit(1);
+    }
     int edges = 0;
-    int safety = 100000; // 무한루프 방지
-    while (edges < M && safety-- > 0) {
-        int u = rand() % N;
-        int v = rand() % N;
+    long long safety = 100000 + 100LL * m; // 무한루프 방지
+    while (edges < m && safety-- > 0) {
+        int u = randBelow(n);
+        int v = randBelow(n);
         if (u == v) continue;
         if (u > v) { int t = u; u = v; v = t; }
-        if (used[u][v]) continue;
-        used[u][v] = 1;
+        if (hasEdge(g, u, v)) continue;
 
-        int w = 1 + rand() % 10;
+        int w = 1 + randBelow(maxW);
         addEdge(g, u, v, w);
         edges++;
     }
-    if (edges < M) {
-        fprintf(stderr, "[ERR] 간선 생성 실패: 생성 %d/%d\n", edges, M);
+    if (edges < m) {
+        fprintf(stderr, "[ERR] 간선 생성 실패: 생성 %d/%d\n", edges, m);
         exit(1);
     }
-    
+}
+
+// 격자 그래프(도로망 흉내): rows x cols 정점, 오른쪽/아래 이웃과 연결, 가중치 1~maxW
+void generateGridGraph(Graph* g, int rows, int cols, int maxW) {
+    if ((long long)rows * cols != g->n) {
+        fprintf(stderr, "[ERR] 격자 크기가 정점 수와 다릅니다: %d x %d != %d\n", rows, cols, g->n);
+        exit(1);
+    }
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int u = r * cols + c;
+            if (c + 1 < cols) addEdge(g, u, u + 1, 1 + randBelow(maxW));
+            if (r + 1 < rows) addEdge(g, u, u + cols, 1 + randBelow(maxW));
+        }
+    }
+}
+
+// 간선 노드들을 정점 순서대로 하나의 연속 블록에 다시 배치(리스트 순서/구조는 그대로).
+// 개별 malloc된 노드는 힙 곳곳에 흩어져 있어 순회마다 캐시 미스가 나므로,
+// 같은 그래프를 여러 번 훑는 APSP 전에 한 번 호출한다. 이후 addEdge는 사용하지 않는다.
+void compactGraph(Graph* g) {
+    if (g->pool) return;
+    size_t arcs = (size_t)g->m * 2;
+    Edge* pool = (Edge*)malloc((arcs ? arcs : 1) * sizeof(Edge));
+    if (!pool) { perror("malloc"); exit(1); }
+    size_t k = 0;
+    for (int u = 0; u < g->n; ++u) {
+        Edge* cur = g->head[u];
+        g->head[u] = cur ? &pool[k] : NULL;
+        while (cur) {
+            Edge* nx = cur->next;
+            pool[k].to = cur->to;
+            pool[k].w = cur->w;
+            pool[k].next = nx ? &pool[k + 1] : NULL;
+            k++;
+            free(cur);
+            cur = nx;
+        }
+    }
+    g->pool = pool;
 }
 
 // 그래프 구조 검증: 각 리스트가 유효 포인터 체인인지 확인
 bool validateGraph(const Graph* g) {
-    for (int u = 0; u < N; ++u) {
-        // 각 정점에 대해서 too long 보호(사이클/자기참조 탐지)
+    for (int u = 0; u < g->n; ++u) {
+        // 각 정점에 대해서 too long 보호(사이클/자기참조 탐지): 단순 그래프의 차수는 n-1 이하
         int seen = 0;
-        for (const Edge* e = g[u].head; e; e = e->next) {
-            if (!validV(e->to)) {
+        for (const Edge* e = g->head[u]; e; e = e->next) {
+            if (!validV(g, e->to)) {
                 fprintf(stderr, "[ERR] 잘못된 to 값: u=%d to=%d\n", u, e->to);
                 return false;
             }
-            if (++seen > 1000) {
+            if (++seen > g->n) {
                 fprintf(stderr, "[ERR] 리스트가 비정상적으로 깁니다(사이클 의심): u=%d\n", u);
                 return false;
             }
@@ -112,53 +352,403 @@ bool validateGraph(const Graph* g) {
     return true;
 }
 
-// Dijkstra (단순 배열 기반 선택, O(N^2 + E))
-void dijkstra(const Graph* g, int src, DijkstraResult* out) {
-    bool vis[N] = {0};
-    for (int i = 0; i < N; ++i) {
+// ========================= 우선순위 큐 =========================
+
+// 위치 색인 이진 힙: 키는 dist 배열을 그대로 참조, pos[v] = 힙 내 위치(-1이면 없음)
+typedef struct {
+    int* heap;
+    int* pos;
+    int size;
+    const int* key;
+} BinHeap;
+
+static void bh_swap(BinHeap* h, int i, int j) {
+    int a = h->heap[i], b = h->heap[j];
+    h->heap[i] = b; h->pos[b] = i;
+    h->heap[j] = a; h->pos[a] = j;
+}
+
+static void bh_up(BinHeap* h, int i) {
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (h->key[h->heap[p]] <= h->key[h->heap[i]]) break;
+        bh_swap(h, i, p);
+        i = p;
+    }
+}
+
+static void bh_down(BinHeap* h, int i) {
+    for (;;) {
+        int l = 2 * i + 1, r = l + 1, best = i;
+        if (l < h->size && h->key[h->heap[l]] < h->key[h->heap[best]]) best = l;
+        if (r < h->size && h->key[h->heap[r]] < h->key[h->heap[best]]) best = r;
+        if (best == i) break;
+        bh_swap(h, i, best);
+        i = best;
+    }
+}
+
+// 삽입 또는 키 감소(key 배열은 호출 전에 이미 갱신)
+static void bh_push_or_decrease(BinHeap* h, int v) {
+    if (h->pos[v] < 0) {
+        h->heap[h->size] = v;
+        h->pos[v] = h->size++;
+    }
+    bh_up(h, h->pos[v]);
+}
+
+static int bh_pop(BinHeap* h) {
+    int top = h->heap[0];
+    h->size--;
+    if (h->size > 0) {
+        h->heap[0] = h->heap[h->size];
+        h->pos[h->heap[0]] = 0;
+        bh_down(h, 0);
+    }
+    h->pos[top] = -1;
+    return top;
+}
+
+// 페어링 힙: 정점마다 노드 하나를 미리 두고, decrease-key는 부분 트리를 잘라 루트와 병합
+typedef struct PNode {
+    int key;
+    struct PNode* child;
+    struct PNode* sibling;
+    struct PNode* prev;     // 첫 자식이면 부모, 아니면 왼쪽 형제
+} PNode;
+
+static PNode* ph_meld(PNode* a, PNode* b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (b->key < a->key) { PNode* t = a; a = b; b = t; }
+    // b를 a의 첫 자식으로
+    b->prev = a;
+    b->sibling = a->child;
+    if (a->child) a->child->prev = b;
+    a->child = b;
+    a->sibling = NULL;
+    a->prev = NULL;
+    return a;
+}
+
+// 두 단계 병합: 왼쪽부터 둘씩 짝지은 뒤 오른쪽부터 차례로 합친다
+static PNode* ph_merge_pairs(PNode* first) {
+    if (!first) return NULL;
+    PNode* pairs = NULL; // 짝 결과를 역순 연결(sibling)로 보관
+    while (first) {
+        PNode* a = first;
+        PNode* b = a->sibling;
+        first = b ? b->sibling : NULL;
+        a->sibling = a->prev = NULL;
+        if (b) { b->sibling = b->prev = NULL; }
+        PNode* m = ph_meld(a, b);
+        m->sibling = pairs;
+        pairs = m;
+    }
+    PNode* root = NULL;
+    while (pairs) {
+        PNode* nx = pairs->sibling;
+        pairs->sibling = NULL;
+        root = ph_meld(root, pairs);
+        pairs = nx;
+    }
+    return root;
+}
+
+static PNode* ph_decrease(PNode* root, PNode* x, int key) {
+    x->key = key;
+    if (x == root) return root;
+    // x를 부모/형제 체인에서 잘라낸다
+    if (x->prev->child == x) x->prev->child = x->sibling;
+    else x->prev->sibling = x->sibling;
+    if (x->sibling) x->sibling->prev = x->prev;
+    x->sibling = x->prev = NULL;
+    return ph_meld(root, x);
+}
+
+// 라딕스 힙 버킷(키, 정점) 가변 배열
+typedef struct { unsigned key; int v; } RadixItem;
+
+typedef struct {
+    RadixItem* items;
+    int size, cap;
+} RadixBucket;
+
+#define RADIX_BUCKETS 33
+
+// Dijkstra 한 번에 필요한 작업 공간. 스레드마다 하나씩 두고 출발점을 바꿔 가며 재사용한다.
+// 각 큐는 실행이 끝나면 빈 상태(pos = -1, 버킷 = -1, 크기 0)로 돌아가므로 재초기화가 필요 없다.
+typedef struct {
+    int n;
+    PqKind pq;
+    bool* vis;
+    int* order;         // 확정(settle) 순서, order[0] = src
+    int settled;
+    BinHeap bh;
+    PNode* nodes;
+    int nb;             // Dial 버킷 수(maxW+1)
+    int* bucket;
+    int* nxt;
+    int* prv;
+    RadixBucket rb[RADIX_BUCKETS];
+} DijkstraWork;
+
+void initWork(DijkstraWork* w, const Graph* g, PqKind pq) {
+    int n = g->n;
+    memset(w, 0, sizeof(*w));
+    w->n = n;
+    w->pq = pq;
+    w->vis = (bool*)malloc((size_t)n * sizeof(bool));
+    w->order = (int*)malloc((size_t)n * sizeof(int));
+    if (!w->vis || !w->order) { perror("malloc"); exit(1); }
+    if (pq == PQ_BINARY) {
+        w->bh.heap = (int*)malloc((size_t)n * sizeof(int));
+        w->bh.pos = (int*)malloc((size_t)n * sizeof(int));
+        if (!w->bh.heap || !w->bh.pos) { perror("malloc"); exit(1); }
+        for (int i = 0; i < n; ++i) w->bh.pos[i] = -1;
+    } else if (pq == PQ_PAIRING) {
+        w->nodes = (PNode*)calloc((size_t)n, sizeof(PNode));
+        if (!w->nodes) { perror("calloc"); exit(1); }
+    } else if (pq == PQ_DIAL) {
+        w->nb = g->maxW + 1;
+        w->bucket = (int*)malloc((size_t)w->nb * sizeof(int));
+        w->nxt = (int*)malloc((size_t)n * sizeof(int));
+        w->prv = (int*)malloc((size_t)n * sizeof(int));
+        if (!w->bucket || !w->nxt || !w->prv) { perror("malloc"); exit(1); }
+        for (int b = 0; b < w->nb; ++b) w->bucket[b] = -1;
+    }
+}
+
+void freeWork(DijkstraWork* w) {
+    free(w->vis);
+    free(w->order);
+    free(w->bh.heap);
+    free(w->bh.pos);
+    free(w->nodes);
+    free(w->bucket);
+    free(w->nxt);
+    free(w->prv);
+    for (int i = 0; i < RADIX_BUCKETS; ++i) free(w->rb[i].items);
+    memset(w, 0, sizeof(*w));
+}
+
+// Dial 버킷 큐: 거리 d인 정점은 버킷 d % (maxW+1)에 들어간다.
+// 아직 확정되지 않은 거리는 항상 [현재 최소, 현재 최소 + maxW] 안에 있으므로 버킷이 겹치지 않는다.
+// 버킷은 정점 번호로 엮은 이중 연결 리스트여서 decrease-key(다른 버킷으로 옮기기)가 O(1).
+static void dijkstraDial(const Graph* g, int src, DijkstraResult* out, DijkstraWork* w) {
+    int nb = w->nb;
+    int* bucket = w->bucket;
+    int* nxt = w->nxt;
+    int* prv = w->prv;
+
+    out->dist[src] = 0;
+    nxt[src] = prv[src] = -1;
+    bucket[0] = src;
+    int queued = 1;
+    int cur = 0;        // 현재 거리(버킷 커서는 cur % nb)
+    int b = 0;
+    while (queued > 0) {
+        // 빈 버킷을 건너뛰며 최소 거리 버킷 탐색(queued > 0이면 nb칸 안에 반드시 있음)
+        while (bucket[b] < 0) {
+            cur++;
+            if (++b == nb) b = 0;
+        }
+        int u = bucket[b];
+        bucket[b] = nxt[u];
+        if (nxt[u] >= 0) prv[nxt[u]] = -1;
+        queued--;
+        w->order[w->settled++] = u;
+
+        for (const Edge* e = g->head[u]; e; e = e->next) {
+            int v = e->to;
+            int nd = cur + e->w;
+            if (nd >= out->dist[v]) continue;
+            if (out->dist[v] < INF) {
+                // 기존 버킷에서 제거
+                int ob = out->dist[v] % nb;
+                if (prv[v] >= 0) nxt[prv[v]] = nxt[v];
+                else bucket[ob] = nxt[v];
+                if (nxt[v] >= 0) prv[nxt[v]] = prv[v];
+            } else {
+                queued++;
+            }
+            out->dist[v] = nd;
+            out->parent[v] = u;
+            int nbk = nd % nb;
+            prv[v] = -1;
+            nxt[v] = bucket[nbk];
+            if (bucket[nbk] >= 0) prv[bucket[nbk]] = v;
+            bucket[nbk] = v;
+        }
+    }
+}
+
+// 라딕스 힙: 꺼낸 최솟값 last 이후의 키만 들어온다는 단조성을 이용.
+// 키 k는 버킷 bit_width(k ^ last)에 넣고, 버킷 0이 비면 첫 비지 않은 버킷의 최솟값을 새 last로
+// 삼아 그 버킷을 더 낮은 버킷들로 재분배한다. 각 원소는 최대 32번 이동하므로 O(log C).
+// decrease-key 대신 새 항목을 넣고 꺼낼 때 낡은 항목(키 != dist)을 버린다.
+static inline int radixIndex(unsigned key, unsigned last) {
+    unsigned x = key ^ last;
+    return x ? 32 - __builtin_clz(x) : 0;
+}
+
+static void radixPush(RadixBucket* bk, unsigned last, unsigned key, int v) {
+    RadixBucket* b = &bk[radixIndex(key, last)];
+    if (b->size == b->cap) {
+        b->cap = b->cap ? b->cap * 2 : 16;
+        b->items = (RadixItem*)realloc(b->items, (size_t)b->cap * sizeof(RadixItem));
+        if (!b->items) { perror("realloc"); exit(1); }
+    }
+    b->items[b->size].key = key;
+    b->items[b->size].v = v;
+    b->size++;
+}
+
+static void dijkstraRadix(const Graph* g, int src, DijkstraResult* out, DijkstraWork* w) {
+    RadixBucket* bk = w->rb;
+    unsigned last = 0;
+    int size = 0;
+
+    out->dist[src] = 0;
+    radixPush(bk, last, 0, src);
+    size++;
+    while (size > 0) {
+        if (bk[0].size == 0) {
+            int i = 1;
+            while (bk[i].size == 0) i++;
+            unsigned mn = UINT_MAX;
+            for (int k = 0; k < bk[i].size; ++k)
+                if (bk[i].items[k].key < mn) mn = bk[i].items[k].key;
+            last = mn;
+            // 재분배: 새 last 기준으로 모두 i보다 낮은 버킷으로 내려간다(버킷 i는 용량만 남김)
+            RadixBucket moving = bk[i];
+            bk[i].items = NULL;
+            bk[i].size = bk[i].cap = 0;
+            for (int k = 0; k < moving.size; ++k)
+                radixPush(bk, last, moving.items[k].key, moving.items[k].v);
+            moving.size = 0;
+            if (bk[i].items == NULL) bk[i] = moving;
+            else free(moving.items);
+        }
+        RadixItem it = bk[0].items[--bk[0].size];
+        size--;
+        int u = it.v;
+        if ((int)it.key != out->dist[u]) continue; // 낡은 항목
+        w->order[w->settled++] = u;
+
+        for (const Edge* e = g->head[u]; e; e = e->next) {
+            int v = e->to;
+            int nd = (int)it.key + e->w;
+            if (nd < out->dist[v]) {
+                out->dist[v] = nd;
+                out->parent[v] = u;
+                radixPush(bk, last, (unsigned)nd, v);
+                size++;
+            }
+        }
+    }
+}
+
+// 작업 공간을 재사용하는 Dijkstra. 큐 종류는 initWork에서 정한 것을 쓴다.
+// 끝나면 w->order[0 .. w->settled)에 확정 순서가 남는다(부모가 항상 자식보다 앞).
+void dijkstraRun(const Graph* g, int src, DijkstraResult* out, DijkstraWork* w) {
+    int n = g->n;
+    PqKind pq = w->pq;
+    for (int i = 0; i < n; ++i) {
         out->dist[i] = INF;
         out->parent[i] = -1;
     }
+    w->settled = 0;
+    if (pq == PQ_DIAL) {
+        dijkstraDial(g, src, out, w);
+        return;
+    }
+    if (pq == PQ_RADIX) {
+        dijkstraRadix(g, src, out, w);
+        return;
+    }
+    bool* vis = w->vis;
+    memset(vis, 0, (size_t)n * sizeof(bool));
     out->dist[src] = 0;
 
-    for (int it = 0; it < N; ++it) {
+    BinHeap* bh = &w->bh;
+    PNode* nodes = w->nodes;
+    PNode* root = NULL;
+    if (pq == PQ_BINARY) {
+        bh->key = out->dist;
+        bh->size = 0;
+        bh_push_or_decrease(bh, src);
+    } else if (pq == PQ_PAIRING) {
+        nodes[src].key = 0;
+        root = &nodes[src];
+    }
+
+    for (;;) {
         // 아직 방문하지 않은 정점 중 dist 최소 선택
-        int u = -1, best = INF;
-        for (int i = 0; i < N; ++i) {
-            if (!vis[i] && out->dist[i] < best) {
-                best = out->dist[i];
-                u = i;
+        int u = -1;
+        if (pq == PQ_ARRAY) {
+            int best = INF;
+            for (int i = 0; i < n; ++i) {
+                if (!vis[i] && out->dist[i] < best) {
+                    best = out->dist[i];
+                    u = i;
+                }
+            }
+        } else if (pq == PQ_BINARY) {
+            if (bh->size > 0) u = bh_pop(bh);
+        } else {
+            if (root) {
+                u = (int)(root - nodes);
+                PNode* kids = root->child;
+                root->child = NULL;
+                root = ph_merge_pairs(kids);
             }
         }
         if (u == -1) break;
         vis[u] = true;
+        w->order[w->settled++] = u;
 
         // 이웃 완화 (방어적으로 next를 먼저 저장)
-        for (Edge* e = g[u].head; e; ) {
+        for (Edge* e = g->head[u]; e; ) {
             Edge* next_e = e->next;
             int v = e->to;
             int nd = out->dist[u] + e->w;
-            if (nd < out->dist[v]) {
+            if (!vis[v] && nd < out->dist[v]) {
+                bool fresh = out->dist[v] >= INF;
                 out->dist[v] = nd;
                 out->parent[v] = u;
+                if (pq == PQ_BINARY) {
+                    bh_push_or_decrease(bh, v);
+                } else if (pq == PQ_PAIRING) {
+                    if (fresh) { nodes[v].key = nd; root = ph_meld(root, &nodes[v]); }
+                    else root = ph_decrease(root, &nodes[v], nd);
+                }
             }
             e = next_e;
         }
     }
 }
 
+// Dijkstra: 우선순위 큐 종류를 실행 시 선택(작업 공간을 매번 할당하는 단발성 버전)
+void dijkstra(const Graph* g, int src, DijkstraResult* out, PqKind pq) {
+    DijkstraWork w;
+    initWork(&w, g, pq);
+    dijkstraRun(g, src, out, &w);
+    freeWork(&w);
+}
+
 // 경로 복원: src->dst 경로를 path 배열에 역순으로 채우고 길이 반환
 int reconstructPath(int src, int dst, const DijkstraResult* r, int* path) {
     if (r->dist[dst] >= INF) return 0; // 경로 없음
     int len = 0;
     int cur = dst;
-    // 방어: 최대 길이 N 초과 방지
-    while (cur != -1 && len < N) {
+    // 방어: 최대 길이 n 초과 방지
+    while (cur != -1 && len < r->n) {
         path[len++] = cur;
         if (cur == src) break;
         cur = r->parent[cur];
     }
-    if (len >= N && path[len - 1] != src) return 0; // 비정상 경로
+    if (len >= r->n && path[len - 1] != src) return 0; // 비정상 경로
     // reverse path
     for (int i = 0; i < len / 2; ++i) {
         int t = path[i];
@@ -168,77 +758,2554 @@ int reconstructPath(int src, int dst, const DijkstraResult* r, int* path) {
     return len;
 }
 
-int main(void) {
-    srand((unsigned)time(NULL));
+// 이진 그래프 파일(graph_file.h)로 저장: 정점별로 to 오름차순 정렬한 가중 CSR
+bool saveGraphFile(const Graph* g, const char* path) {
+    int n = g->n;
+    uint64_t* off = (uint64_t*)malloc(((size_t)n + 1) * sizeof(uint64_t));
+    if (!off) { perror("malloc"); exit(1); }
+    off[0] = 0;
+    for (int u = 0; u < n; ++u) {
+        uint64_t d = 0;
+        for (const Edge* e = g->head[u]; e; e = e->next) d++;
+        off[u + 1] = off[u] + d;
+    }
+    int32_t* adj = (int32_t*)malloc((off[n] ? off[n] : 1) * sizeof(int32_t));
+    int32_t* w = (int32_t*)malloc((off[n] ? off[n] : 1) * sizeof(int32_t));
+    if (!adj || !w) { perror("malloc"); exit(1); }
+    for (int u = 0; u < n; ++u) {
+        uint64_t k = off[u];
+        for (const Edge* e = g->head[u]; e; e = e->next) {
+            // 삽입 정렬로 (to, w) 쌍을 to 오름차순 유지
+            uint64_t j = k++;
+            while (j > off[u] && adj[j - 1] > e->to) {
+                adj[j] = adj[j - 1];
+                w[j] = w[j - 1];
+                j--;
+            }
+            adj[j] = e->to;
+            w[j] = e->w;
+        }
+    }
+    bool ok = gf_write(path, (uint64_t)n, off, adj, w);
+    free(off);
+    free(adj);
+    free(w);
+    return ok;
+}
+
+// 이진 그래프 파일에서 그래프 생성(가중치가 없으면 1). u < v 간선만 읽어 양방향 추가.
+// 이웃 번호가 범위 밖이거나 가중치가 음수이면 실패.
+bool loadGraphFile(Graph* g, const char* path) {
+    GraphFile gf;
+    if (!gf_open(path, &gf)) return false;
+    if (gf.n > (uint64_t)INT_MAX) {
+        fprintf(stderr, "[ERR] 정점 수가 너무 큽니다: %s\n", path);
+        gf_close(&gf);
+        return false;
+    }
+    initGraph(g, (int)gf.n);
+    // 리스트 앞에 붙이므로 역순으로 넣어 파일과 같은 순서를 유지
+    for (int u = (int)gf.n - 1; u >= 0; --u) {
+        for (uint64_t i = gf.off[u + 1]; i > gf.off[u]; --i) {
+            int v = gf.adj[i - 1];
+            if (!validV(g, v)) {
+                fprintf(stderr, "[ERR] 잘못된 이웃 번호: u=%d v=%d\n", u, v);
+                gf_close(&gf);
+                freeGraph(g);
+                return false;
+            }
+            if (v <= u) continue;
+            int w = gf.w ? gf.w[i - 1] : 1;
+            // Dijkstra/Dial/radix/델타 스테핑 모두 음이 아닌 가중치를 가정하고, INF 이상이면 거리 합이 넘친다
+            if (w < 0 || w >= INF) {
+                fprintf(stderr, "[ERR] 가중치 범위 오류(0 ~ %d): u=%d v=%d w=%d\n", INF - 1, u, v, w);
+                gf_close(&gf);
+                freeGraph(g);
+                return false;
+            }
+            addEdge(g, u, v, w);    // maxW는 실제로 읽은 가중치의 최댓값이 된다(initGraph에서 0)
+        }
+    }
+    gf_close(&gf);
+    return true;
+}
+
+// 모든 종류의 큐로 src에서 Dijkstra를 돌려 시간과 결과 일치 여부 출력
+static void benchmarkSssp(const Graph* g, int src, bool includeArray) {
+    DijkstraResult ref, r;
+    initResult(&ref, g->n);
+    initResult(&r, g->n);
+    int first = includeArray ? PQ_ARRAY : PQ_BINARY;
+    for (int k = first; k <= PQ_RADIX; ++k) {
+        // 처음 돈 큐의 결과를 기준으로 나머지와 거리 배열 비교
+        DijkstraResult* out = k == first ? &ref : &r;
+        clock_t t0 = clock();
+        dijkstra(g, src, out, (PqKind)k);
+        double sec = (double)(clock() - t0) / CLOCKS_PER_SEC;
+        bool same = k == first || memcmp(ref.dist, r.dist, (size_t)g->n * sizeof(int)) == 0;
+        printf("  %-8s : %.3f초%s\n", pqName((PqKind)k), sec, same ? "" : "  [ERR] 거리 불일치");
+    }
+    long long reach = 0, sum = 0;
+    for (int i = 0; i < g->n; ++i) if (ref.dist[i] < INF) { reach++; sum += ref.dist[i]; }
+    printf("  도달 정점 %lld, 평균 거리 %.2f\n", reach, reach ? (double)sum / reach : 0.0);
+    freeResult(&ref);
+    freeResult(&r);
+}
 
-    Graph g[N];
-    initGraph(g);
+// ========================= 모든 쌍 최단경로(병렬) =========================
 
-    generateRandomGraph(g);
+// 미리 할당한 n x n 거리 행렬. 행 s = 출발점 s의 거리.
+// narrow이면 16비트로 저장하고 APSP_D16_INF(0xFFFF)는 도달 불가 또는 범위 초과.
+// hop[s*n + t] = s에서 t로 가는 최단경로의 두 번째 정점(s == t면 s, 도달 불가면 -1).
+#define APSP_D16_INF 0xFFFFu
 
-    // 출력 전 구조 검증
-    if (!validateGraph(g)) {
-        fprintf(stderr, "[ERR] 그래프 구조가 손상되었습니다.\n");
-        freeGraph(g);
-        return 1;
+typedef struct {
+    int n;
+    bool narrow;
+    int32_t* d32;
+    uint16_t* d16;
+    int32_t* hop;
+} ApspMatrix;
+
+typedef struct {
+    long long reach;        // 도달 가능한 (s, t) 쌍 수(s == t 포함)
+    long long sum;          // 도달 가능한 쌍의 거리 합
+    int maxDist;            // 지름(도달 가능한 쌍 중 최대 거리)
+    long long overflow;     // 16비트에 담지 못한 거리 수
+    double sec;
+} ApspStats;
+
+// store: 0 = 저장 안 함(통계만), 16 / 32 = 거리 비트 수
+bool initApsp(ApspMatrix* M, int n, int store, bool withHop) {
+    memset(M, 0, sizeof(*M));
+    M->n = n;
+    M->narrow = store == 16;
+    size_t cells = (size_t)n * (size_t)n;
+    if (store == 32) M->d32 = (int32_t*)malloc(cells * sizeof(int32_t));
+    if (store == 16) M->d16 = (uint16_t*)malloc(cells * sizeof(uint16_t));
+    if (withHop) M->hop = (int32_t*)malloc(cells * sizeof(int32_t));
+    if ((store == 32 && !M->d32) || (store == 16 && !M->d16) || (withHop && !M->hop)) {
+        perror("apsp matrix malloc");
+        free(M->d32);
+        free(M->d16);
+        free(M->hop);
+        return false;
     }
+    return true;
+}
 
-    // 생성된 그래프(간선 목록) 출력: u < v만 한 번 출력
-    printf("무작위 무방향 가중 그래프 생성 (정점 수=%d, 간선 수=%d)\n", N, M);
-    int printed[N][N] = {0};
-    for (int u = 0; u < N; ++u) {
-        // 방어: head가 NULL일 수도 있음
-        if (g[u].head == NULL) 
-            continue; // NULL인 경우 건너뛰기
-        Edge* e = g[u].head;
-        int guard = 10000; // 비정상 루프 방지
-        while (e && guard-- > 0) {
-            if (e == NULL) break; // 방어 코드 추가
-            int v = e->to;
-            if (validV(v)) {
-                if (u < v && !printed[u][v]) {
-                    printed[u][v] = 1;
-                    printf("간선 %2d - %2d, 가중치=%d\n", u, v, e->w);
+void freeApsp(ApspMatrix* M) {
+    free(M->d32);
+    free(M->d16);
+    free(M->hop);
+    memset(M, 0, sizeof(*M));
+}
+
+// 출발점들을 스레드에 동적으로 나눠 각자 작업 공간으로 Dijkstra 실행.
+// 32비트 행렬이면 결과를 행에 직접 쓰고(복사 없음), 다음 정점 표는 확정 순서대로
+// hop[v] = (parent[v] == s) ? v : hop[parent[v]] 로 채운다(부모가 먼저 확정되므로 한 번에 끝남).
+void apspParallel(const Graph* g, PqKind pq, ApspMatrix* M, ApspStats* st) {
+    int n = g->n;
+    long long reach = 0, sum = 0, overflow = 0;
+    int maxDist = 0;
+    double t0 = now_sec();
+
+    #pragma omp parallel reduction(+:reach, sum, overflow) reduction(max:maxDist)
+    {
+        DijkstraWork w;
+        DijkstraResult r;
+        initWork(&w, g, pq);
+        initResult(&r, n);
+        int* ownDist = r.dist;
+
+        #pragma omp for schedule(dynamic, 8)
+        for (int s = 0; s < n; ++s) {
+            size_t row = (size_t)s * (size_t)n;
+            r.dist = M->d32 ? M->d32 + row : ownDist;
+            dijkstraRun(g, s, &r, &w);
+
+            // 확정된 정점만 훑어 통계(도달 불가 정점은 settle되지 않음)
+            for (int i = 0; i < w.settled; ++i) {
+                int d = r.dist[w.order[i]];
+                sum += d;
+                if (d > maxDist) maxDist = d;
+            }
+            reach += w.settled;
+
+            if (M->d16) {
+                uint16_t* out = M->d16 + row;
+                for (int t = 0; t < n; ++t) {
+                    int d = r.dist[t];
+                    if (d >= INF) out[t] = APSP_D16_INF;
+                    else if ((unsigned)d >= APSP_D16_INF) { out[t] = APSP_D16_INF; overflow++; }
+                    else out[t] = (uint16_t)d;
+                }
+            }
+            if (M->hop) {
+                int32_t* hop = M->hop + row;
+                for (int t = 0; t < n; ++t) hop[t] = -1;
+                hop[s] = s;
+                for (int i = 1; i < w.settled; ++i) {
+                    int v = w.order[i];
+                    int p = r.parent[v];
+                    hop[v] = p == s ? v : hop[p];
                 }
-            } else {
-                fprintf(stderr, "[WARN] 잘못된 to 값 감지: u=%d to=%d\n", u, v);
-                break;
             }
-            e = e->next;
         }
-        if (guard <= 0) {
-            fprintf(stderr, "[ERR] 간선 출력 중 비정상 루프 의심: u=%d\n", u);
-            freeGraph(g);
-            return 1;
+        r.dist = ownDist;
+        freeResult(&r);
+        freeWork(&w);
+    }
+    st->sec = now_sec() - t0;
+    st->reach = reach;
+    st->sum = sum;
+    st->maxDist = maxDist;
+    st->overflow = overflow;
+}
+
+// 다음 정점 표로 s->t 경로를 path에 채우고 길이 반환(없으면 0)
+int apspPath(const ApspMatrix* M, int s, int t, int* path) {
+    size_t n = (size_t)M->n;
+    if (!M->hop || M->hop[(size_t)s * n + t] < 0) return 0;
+    int len = 0;
+    path[len++] = s;
+    while (s != t && len <= M->n) {
+        s = M->hop[(size_t)s * n + t];
+        path[len++] = s;
+    }
+    return s == t ? len : 0;
+}
+
+// ========================= 블록 Floyd-Warshall(조밀 그래프 APSP) =========================
+
+// 타일 하나에 대한 min-plus 갱신: C[i][j] = min(C[i][j], A[i][k] + B[k][j]), k는 타일 안에서 0..bs-1.
+// 값이 줄면 다음 정점도 Cn[i][j] = An[i][k] (i에서 k로 가는 첫 걸음)로 바꾼다.
+// INF(0x3f3f3f3f) 두 개를 더해도 int 범위 안이므로 포화 연산이 필요 없다.
+// 대각 타일 단계에서는 A, B, C가 같은 타일이지만 d[k][k] = 0이라 k행/열은 반복 k 동안 변하지 않는다.
+static void fwTile(int* C, int* Cn, const int* A, const int* An, const int* B, size_t ld) {
+    for (int k = 0; k < FW_BLOCK; ++k) {
+        const int* brow = B + (size_t)k * ld;
+        for (int i = 0; i < FW_BLOCK; ++i) {
+            int aik = A[(size_t)i * ld + k];
+            if (aik >= INF) continue;
+            int hop = An[(size_t)i * ld + k];
+            int* crow = C + (size_t)i * ld;
+            int* nrow = Cn + (size_t)i * ld;
+#ifdef __AVX2__
+            __m256i va = _mm256_set1_epi32(aik);
+            __m256i vh = _mm256_set1_epi32(hop);
+            for (int j = 0; j < FW_BLOCK; j += 8) {
+                __m256i c = _mm256_loadu_si256((const __m256i*)(crow + j));
+                __m256i sum = _mm256_add_epi32(va, _mm256_loadu_si256((const __m256i*)(brow + j)));
+                __m256i lt = _mm256_cmpgt_epi32(c, sum);
+                if (_mm256_testz_si256(lt, lt)) continue;
+                _mm256_storeu_si256((__m256i*)(crow + j), _mm256_min_epi32(c, sum));
+                __m256i nh = _mm256_loadu_si256((const __m256i*)(nrow + j));
+                _mm256_storeu_si256((__m256i*)(nrow + j), _mm256_blendv_epi8(nh, vh, lt));
+            }
+#else
+            for (int j = 0; j < FW_BLOCK; ++j) {
+                int sum = aik + brow[j];
+                if (sum < crow[j]) {
+                    crow[j] = sum;
+                    nrow[j] = hop;
+                }
+            }
+#endif
         }
     }
-    printf("\n");
+}
 
-    // 모든 쌍 최단경로 계산
-    DijkstraResult res[N];
-    for (int s = 0; s < N; ++s) {
-        dijkstra(g, s, &res[s]);
+// 세 단계 블록 FW: (1) 대각 타일 (2) 같은 행/열의 타일들 (3) 나머지 타일들. (2)(3)은 타일 단위 병렬.
+// 행렬은 FW_BLOCK 배수로 패딩한 n x n(패딩 칸은 INF라 결과에 영향 없음)으로 내부에서 만들고
+// 끝나면 ApspMatrix 형식(d32/d16/hop)으로 옮긴다.
+void floydWarshall(const Graph* g, ApspMatrix* M, ApspStats* st) {
+    int n = g->n;
+    int nb = (n + FW_BLOCK - 1) / FW_BLOCK;
+    size_t ld = (size_t)nb * FW_BLOCK;
+    int* d = (int*)malloc(ld * ld * sizeof(int));
+    int* nx = (int*)malloc(ld * ld * sizeof(int));
+    if (!d || !nx) { perror("fw matrix malloc"); exit(1); }
+    double t0 = now_sec();
+
+    #pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < ld; ++i) {
+        for (size_t j = 0; j < ld; ++j) {
+            d[i * ld + j] = i == j ? 0 : INF;
+            nx[i * ld + j] = i == j ? (int)i : -1;
+        }
+        if (i < (size_t)n) {
+            for (const Edge* e = g->head[i]; e; e = e->next) {
+                if (e->w < d[i * ld + e->to]) {
+                    d[i * ld + e->to] = e->w;
+                    nx[i * ld + e->to] = e->to;
+                }
+            }
+        }
     }
 
-    // 45쌍(u<v) 결과 출력
-    printf("모든 노드 쌍(u < v)의 최단경로 결과:\n");
-    for (int u = 0; u < N; ++u) {
-        for (int v = u + 1; v < N; ++v) {
-            int path[N];
-            int len = reconstructPath(u, v, &res[u], path);
-            if (len == 0) {
-                printf("%2d -> %2d : 거리 = INF, 경로 = (없음)\n", u, v);
-            } else {
-                printf("%2d -> %2d : 거리 = %d, 경로 = ", u, v, res[u].dist[v]);
-                for (int i = 0; i < len; ++i) {
-                    if (i) printf(" -> ");
-                    printf("%d", path[i]);
+#define FW_AT(m, bi, bj) ((m) + (size_t)(bi) * FW_BLOCK * ld + (size_t)(bj) * FW_BLOCK)
+    for (int kb = 0; kb < nb; ++kb) {
+        int* dkk = FW_AT(d, kb, kb);
+        fwTile(dkk, FW_AT(nx, kb, kb), dkk, FW_AT(nx, kb, kb), dkk, ld);
+
+        // 행 kb의 타일(A = 대각)과 열 kb의 타일(B = 대각)
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int t = 0; t < 2 * nb; ++t) {
+            int b = t % nb;
+            if (b == kb) continue;
+            if (t < nb) fwTile(FW_AT(d, kb, b), FW_AT(nx, kb, b), dkk, FW_AT(nx, kb, kb), FW_AT(d, kb, b), ld);
+            else fwTile(FW_AT(d, b, kb), FW_AT(nx, b, kb), FW_AT(d, b, kb), FW_AT(nx, b, kb), dkk, ld);
+        }
+
+        // 나머지: C(i,j) ← A(i,kb) + B(kb,j)
+        #pragma omp parallel for collapse(2) schedule(dynamic, 4)
+        for (int bi = 0; bi < nb; ++bi) {
+            for (int bj = 0; bj < nb; ++bj) {
+                if (bi == kb || bj == kb) continue;
+                fwTile(FW_AT(d, bi, bj), FW_AT(nx, bi, bj), FW_AT(d, bi, kb), FW_AT(nx, bi, kb),
+                       FW_AT(d, kb, bj), ld);
+            }
+        }
+    }
+#undef FW_AT
+
+    // ApspMatrix로 옮기며 통계
+    long long reach = 0, sum = 0, overflow = 0;
+    int maxDist = 0;
+    #pragma omp parallel for schedule(static) reduction(+:reach, sum, overflow) reduction(max:maxDist)
+    for (int s = 0; s < n; ++s) {
+        const int* drow = d + (size_t)s * ld;
+        size_t row = (size_t)s * (size_t)n;
+        for (int t = 0; t < n; ++t) {
+            int v = drow[t];
+            if (v < INF) {
+                reach++;
+                sum += v;
+                if (v > maxDist) maxDist = v;
+            }
+            if (M->d16) {
+                if (v >= INF) M->d16[row + t] = APSP_D16_INF;
+                else if ((unsigned)v >= APSP_D16_INF) { M->d16[row + t] = APSP_D16_INF; overflow++; }
+                else M->d16[row + t] = (uint16_t)v;
+            }
+        }
+        if (M->d32) memcpy(M->d32 + row, drow, (size_t)n * sizeof(int));
+        if (M->hop) memcpy(M->hop + row, nx + (size_t)s * ld, (size_t)n * sizeof(int));
+    }
+    st->sec = now_sec() - t0;
+    st->reach = reach;
+    st->sum = sum;
+    st->maxDist = maxDist;
+    st->overflow = overflow;
+    free(d);
+    free(nx);
+}
+
+// 비용 모델로 APSP 방법 선택: 한 출발점당 Dijkstra는 (2m*ARC + n*VERT),
+// FW는 n*n*CELL(타일 SIMD 기준)이므로 조밀할수록 FW가 유리하다.
+static bool apspPreferFw(const Graph* g) {
+    double dij = 2.0 * g->m * APSP_ARC_NS + (double)g->n * APSP_VERT_NS;
+    double fw = (double)g->n * g->n * APSP_CELL_NS;
+#ifndef __AVX2__
+    fw *= 6.0;  // 스칼라 경로
+#endif
+    return fw < dij;
+}
+
+// 병렬 APSP 실행/검증: 처음 몇 출발점은 직렬 이진 힙 Dijkstra와 행 단위로 대조
+static int runApsp(Graph* g, int argc, char** argv, int firstOpt) {
+    int n = g->n;
+    int store = -1;
+    bool withHop = false;
+    int method = -1;    // 0 = Dijkstra, 1 = FW, -1 = 비용 모델
+    PqKind pq = defaultPq(g);
+    for (int i = firstOpt; i < argc; ++i) {
+        if (strcmp(argv[i], "fw") == 0) method = 1;
+        else if (strcmp(argv[i], "dijkstra") == 0) method = 0;
+        else if (strcmp(argv[i], "d16") == 0) store = 16;
+        else if (strcmp(argv[i], "d32") == 0) store = 32;
+        else if (strcmp(argv[i], "none") == 0) store = 0;
+        else if (strcmp(argv[i], "hop") == 0) withHop = true;
+        else if (!parsePq(argv[i], &pq)) {
+            fprintf(stderr, "[ERR] 알 수 없는 apsp 옵션: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (store < 0) {
+        // 기본: 32비트 행렬이 한도 안이면 저장, 아니면 통계만
+        store = (unsigned long long)n * n * 4 <= APSP_MATRIX_LIMIT ? 32 : 0;
+        if (store == 0) printf("(행렬이 %.1f GB라 저장하지 않습니다. d16/d32로 강제 가능)\n",
+                               (double)n * n * 4 / (1u << 30));
+    }
+
+    compactGraph(g);
+    ApspMatrix M;
+    if (!initApsp(&M, n, store, withHop)) return 1;
+    bool useFw = method < 0 ? apspPreferFw(g) : method == 1;
+    printf("정점 %d, 간선 %d, 최대 가중치 %d, 스레드 %d, 방법 %s%s, 저장 %s%s\n",
+           n, g->m, g->maxW, thread_count(), useFw ? "floyd-warshall" : "dijkstra/",
+           useFw ? "" : pqName(pq), store == 32 ? "d32" : store == 16 ? "d16" : "없음",
+           withHop ? " + 다음 정점 표" : "");
+    ApspStats st;
+    if (useFw) floydWarshall(g, &M, &st);
+    else apspParallel(g, pq, &M, &st);
+    printf("  시간 %.3f초 (%.0f 출발점/초)\n", st.sec, st.sec > 0 ? n / st.sec : 0.0);
+    printf("  도달 쌍 %lld / %lld, 평균 거리 %.2f, 지름 %d\n", st.reach, (long long)n * n,
+           st.reach ? (double)st.sum / st.reach : 0.0, st.maxDist);
+    if (M.narrow && st.overflow)
+        printf("  [WARN] 16비트 범위를 넘는 거리 %lld개는 도달 불가로 기록됨\n", st.overflow);
+
+    // 검증
+    int bad = 0;
+    DijkstraResult ref;
+    initResult(&ref, n);
+    int* path = (int*)malloc((size_t)n * sizeof(int));
+    if (!path) { perror("malloc"); exit(1); }
+    for (int k = 0; k < APSP_VERIFY && k < n; ++k) {
+        int s = (int)((long long)k * n / APSP_VERIFY);
+        dijkstra(g, s, &ref, PQ_BINARY);
+        size_t row = (size_t)s * (size_t)n;
+        for (int t = 0; t < n && !bad; ++t) {
+            int d = ref.dist[t];
+            if (M.d32 && M.d32[row + t] != d) bad = 1;
+            if (M.d16) {
+                unsigned want = (d >= INF || (unsigned)d >= APSP_D16_INF) ? APSP_D16_INF : (unsigned)d;
+                if (M.d16[row + t] != want) bad = 1;
+            }
+            if (M.hop) {
+                // 다음 정점 표를 따라간 경로의 가중치 합이 최단거리와 같은지
+                int len = apspPath(&M, s, t, path);
+                if ((len == 0) != (d >= INF)) bad = 1;
+                int acc = 0;
+                for (int i = 0; i + 1 < len && !bad; ++i) {
+                    const Edge* e = g->head[path[i]];
+                    while (e && e->to != path[i + 1]) e = e->next;
+                    if (!e) bad = 1;
+                    else acc += e->w;
                 }
-                printf("\n");
+                if (len && acc != d) bad = 1;
             }
         }
+        if (bad) {
+            printf("  [ERR] 출발점 %d 결과가 직렬 Dijkstra와 다릅니다\n", s);
+            break;
+        }
     }
+    if (!bad) printf("  검증: 출발점 %d개 직렬 결과와 일치\n", APSP_VERIFY < n ? APSP_VERIFY : n);
+    free(path);
+    freeResult(&ref);
+    freeApsp(&M);
+    return bad;
+}
 
-    freeGraph(g);
-    return 0;
-}
\ No newline at end of file
+// ========================= 델타 스테핑(단일 출발, 스레드 병렬) =========================
+
+// 가중 CSR: 정점 u의 간선은 [off[u], off[u+1])에 가중치 오름차순으로 놓인다.
+// 덕분에 어떤 delta든 앞쪽(w <= delta)이 가벼운 간선, 뒤쪽이 무거운 간선이 되어 따로 나눌 필요가 없다.
+typedef struct {
+    int n;
+    size_t* off;
+    int* adj;
+    int* w;
+} WCsr;
+
+static int cmpU64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a, y = *(const uint64_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+void buildWCsr(const Graph* g, WCsr* c) {
+    int n = g->n;
+    size_t arcs = (size_t)g->m * 2;
+    c->n = n;
+    c->off = (size_t*)malloc(((size_t)n + 1) * sizeof(size_t));
+    c->adj = (int*)malloc((arcs ? arcs : 1) * sizeof(int));
+    c->w = (int*)malloc((arcs ? arcs : 1) * sizeof(int));
+    uint64_t* tmp = (uint64_t*)malloc((arcs ? arcs : 1) * sizeof(uint64_t));
+    if (!c->off || !c->adj || !c->w || !tmp) { perror("malloc"); exit(1); }
+    size_t k = 0;
+    for (int u = 0; u < n; ++u) {
+        c->off[u] = k;
+        for (const Edge* e = g->head[u]; e; e = e->next)
+            tmp[k++] = ((uint64_t)(uint32_t)e->w << 32) | (uint32_t)e->to;
+        qsort(tmp + c->off[u], k - c->off[u], sizeof(uint64_t), cmpU64);
+    }
+    c->off[n] = k;
+    for (size_t i = 0; i < k; ++i) {
+        c->adj[i] = (int)(uint32_t)tmp[i];
+        c->w[i] = (int)(tmp[i] >> 32);
+    }
+    free(tmp);
+}
+
+void freeWCsr(WCsr* c) {
+    free(c->off);
+    free(c->adj);
+    free(c->w);
+    memset(c, 0, sizeof(*c));
+}
+
+// 원자적 최솟값 갱신(CAS 루프). 값을 줄였으면 true.
+static inline bool atomicMinInt(int* p, int v) {
+    int old = __atomic_load_n(p, __ATOMIC_RELAXED);
+    while (v < old) {
+        if (__atomic_compare_exchange_n(p, &old, v, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            return true;
+    }
+    return false;
+}
+
+typedef struct {
+    int* a;
+    int size, cap;
+} IntVec;
+
+static inline void ivPush(IntVec* v, int x) {
+    if (v->size == v->cap) {
+        v->cap = v->cap ? v->cap * 2 : 64;
+        v->a = (int*)realloc(v->a, (size_t)v->cap * sizeof(int));
+        if (!v->a) { perror("realloc"); exit(1); }
+    }
+    v->a[v->size++] = x;
+}
+
+// 스레드별 버킷(절대 번호 = 거리 / delta)과 현재 버킷에서 확정된 정점 목록 R
+typedef struct {
+    IntVec* bins;
+    int nbins;
+    IntVec settled;
+    char pad[64];       // 인접 스레드 구조체와 캐시 라인 공유 방지
+} DsLocal;
+
+static inline void dsPushBin(DsLocal* L, int b, int v) {
+    if (b >= L->nbins) {
+        int nb = L->nbins ? L->nbins : 16;
+        while (nb <= b) nb *= 2;
+        L->bins = (IntVec*)realloc(L->bins, (size_t)nb * sizeof(IntVec));
+        if (!L->bins) { perror("realloc"); exit(1); }
+        memset(L->bins + L->nbins, 0, (size_t)(nb - L->nbins) * sizeof(IntVec));
+        L->nbins = nb;
+    }
+    ivPush(&L->bins[b], v);
+}
+
+typedef struct {
+    int buckets;            // 처리한 버킷 수
+    int phases;             // 가벼운 간선 반복 + 무거운 간선 단계 수
+    long long relax;        // 성공한 완화 수
+} DsStats;
+
+// 델타 스테핑(Meyer & Sanders). 현재 버킷 B의 정점들은 가벼운 간선(w <= delta)으로만 완화하며
+// B가 빌 때까지 반복하고, 그동안 확정된 정점들에서 무거운 간선을 한 번 완화한 뒤 다음 버킷으로 간다.
+// 완화는 CAS 원자적 최솟값이고, 새로 들어갈 버킷은 스레드별 버킷에 모았다가 다음 frontier로 합친다.
+// parent는 끝난 뒤 dist[u] + w == dist[v]인 이웃 u로 채운다(양의 가중치라 유효한 최단경로 트리).
+void deltaStepping(const WCsr* G, int src, int delta, DijkstraResult* out, DsStats* st) {
+    int n = G->n;
+    int* dist = out->dist;
+    int T = thread_count();
+    DsLocal* loc = (DsLocal*)calloc((size_t)T, sizeof(DsLocal));
+    int* stamp = (int*)malloc((size_t)n * sizeof(int));   // 마지막으로 R에 넣은 버킷 번호
+    size_t fcap = 1024;
+    int* frontier = (int*)malloc(fcap * sizeof(int));
+    if (!loc || !stamp || !frontier) { perror("malloc"); exit(1); }
+    for (int i = 0; i < n; ++i) {
+        dist[i] = INF;
+        stamp[i] = -1;
+    }
+    dist[src] = 0;
+    frontier[0] = src;
+    size_t fsize = 1;
+    int cur = 0, next = 0;
+    long long pending = 0, relax = 0;
+    size_t need = 0;
+    int buckets = 0, phases = 0;
+
+    #pragma omp parallel reduction(+:relax)
+    {
+        DsLocal* L = &loc[thread_id()];
+        for (;;) {
+            // 1) 현재 버킷 frontier에서 가벼운 간선 완화
+            #pragma omp for schedule(dynamic, 64)
+            for (size_t i = 0; i < fsize; ++i) {
+                int u = frontier[i];
+                int du = __atomic_load_n(&dist[u], __ATOMIC_RELAXED);
+                if (du / delta != cur) continue;    // 같은 정점이 두 번 들어온 경우 등
+                if (stamp[u] != cur) {
+                    stamp[u] = cur;                 // 경쟁 시 R에 중복될 뿐 결과는 같다
+                    ivPush(&L->settled, u);
+                }
+                for (size_t k = G->off[u]; k < G->off[u + 1] && G->w[k] <= delta; ++k) {
+                    int nd = du + G->w[k];
+                    if (atomicMinInt(&dist[G->adj[k]], nd)) {
+                        dsPushBin(L, nd / delta, G->adj[k]);
+                        relax++;
+                    }
+                }
+            }
+            #pragma omp single
+            {
+                pending = 0;
+                next = INT_MAX;
+                need = 0;
+                phases++;
+            }
+            if (cur < L->nbins) __atomic_fetch_add(&pending, L->bins[cur].size, __ATOMIC_RELAXED);
+            #pragma omp barrier
+
+            // 2) 현재 버킷이 비었으면 R에서 무거운 간선 완화(각 스레드가 자기 R만)
+            if (pending == 0) {
+                for (int i = 0; i < L->settled.size; ++i) {
+                    int u = L->settled.a[i];
+                    int du = __atomic_load_n(&dist[u], __ATOMIC_RELAXED);
+                    size_t k = G->off[u + 1];
+                    while (k > G->off[u] && G->w[k - 1] > delta) k--;
+                    for (; k < G->off[u + 1]; ++k) {
+                        int nd = du + G->w[k];
+                        if (atomicMinInt(&dist[G->adj[k]], nd)) {
+                            dsPushBin(L, nd / delta, G->adj[k]);
+                            relax++;
+                        }
+                    }
+                }
+                L->settled.size = 0;
+            }
+
+            // 3) 비어 있지 않은 가장 낮은 버킷 선택(현재 버킷에 남은 게 있으면 그대로 반복)
+            int myMin = INT_MAX;
+            for (int b = cur; b < L->nbins; ++b)
+                if (L->bins[b].size > 0) { myMin = b; break; }
+            if (myMin != INT_MAX) {
+                int seen = __atomic_load_n(&next, __ATOMIC_RELAXED);
+                while (myMin < seen &&
+                       !__atomic_compare_exchange_n(&next, &seen, myMin, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                }
+            }
+            #pragma omp barrier
+            if (next == INT_MAX) break;
+
+            // 4) 스레드별 버킷 next를 frontier 하나로 합침
+            int nb = next;
+            size_t mine = nb < L->nbins ? (size_t)L->bins[nb].size : 0;
+            size_t at = __atomic_fetch_add(&need, mine, __ATOMIC_RELAXED);
+            #pragma omp barrier
+            #pragma omp single
+            {
+                if (need > fcap) {
+                    while (fcap < need) fcap *= 2;
+                    frontier = (int*)realloc(frontier, fcap * sizeof(int));
+                    if (!frontier) { perror("realloc"); exit(1); }
+                }
+                if (nb != cur) buckets++;
+            }
+            if (mine) {
+                memcpy(frontier + at, L->bins[nb].a, mine * sizeof(int));
+                L->bins[nb].size = 0;
+            }
+            #pragma omp barrier
+            #pragma omp single
+            {
+                fsize = need;
+                cur = nb;
+            }
+        }
+    }
+
+    // parent 복원
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int v = 0; v < n; ++v) {
+        out->parent[v] = -1;
+        if (v == src || dist[v] >= INF) continue;
+        for (size_t k = G->off[v]; k < G->off[v + 1]; ++k) {
+            int u = G->adj[k];
+            if (dist[u] < INF && dist[u] + G->w[k] == dist[v]) {
+                out->parent[v] = u;
+                break;
+            }
+        }
+    }
+
+    if (st) {
+        st->buckets = buckets + 1;
+        st->phases = phases;
+        st->relax = relax;
+    }
+    for (int t = 0; t < T; ++t) {
+        for (int b = 0; b < loc[t].nbins; ++b) free(loc[t].bins[b].a);
+        free(loc[t].bins);
+        free(loc[t].settled.a);
+    }
+    free(loc);
+    free(stamp);
+    free(frontier);
+}
+
+// 델타 스테핑 검증/확장성: 직렬 Dijkstra와 거리 비교, 스레드 1, 2, 4, ...에서 시간과 가속비
+static int runDelta(Graph* g, int delta) {
+    int n = g->n;
+    compactGraph(g);
+    if (delta <= 0) {
+        // 기본값: 평균 차수 d일 때 maxW / d 정도(버킷당 일감과 재완화 수의 균형)
+        int avgDeg = n ? (int)(2LL * g->m / n) : 1;
+        delta = g->maxW / (avgDeg > 0 ? avgDeg : 1);
+        if (delta < 1) delta = 1;
+    }
+    WCsr G;
+    buildWCsr(g, &G);
+    DijkstraResult ref, r;
+    initResult(&ref, n);
+    initResult(&r, n);
+    PqKind pq = defaultPq(g);
+    double t0 = now_sec();
+    dijkstra(g, 0, &ref, pq);
+    double base = now_sec() - t0;
+    printf("정점 %d, 간선 %d, 최대 가중치 %d, delta %d\n", n, g->m, g->maxW, delta);
+    printf("  dijkstra(%s) : %.3f초\n", pqName(pq), base);
+
+    int maxT = thread_count();
+    double one = 0;
+    int bad = 0;
+    for (int t = 1; ; t *= 2) {
+        if (t > maxT) t = maxT;
+        set_thread_count(t);
+        DsStats st;
+        t0 = now_sec();
+        deltaStepping(&G, 0, delta, &r, &st);
+        double sec = now_sec() - t0;
+        if (t == 1) one = sec;
+        bool same = memcmp(ref.dist, r.dist, (size_t)n * sizeof(int)) == 0;
+        // parent가 최단경로 트리인지: 부모 거리 + 간선 가중치 == 자기 거리
+        for (int v = 0; v < n && same; ++v) {
+            int p = r.parent[v];
+            if (v == 0 || r.dist[v] >= INF) continue;
+            if (p < 0) { same = false; break; }
+            const Edge* e = g->head[p];
+            while (e && e->to != v) e = e->next;
+            if (!e || r.dist[p] + e->w != r.dist[v]) same = false;
+        }
+        printf("  delta-stepping 스레드 %2d : %.3f초 (x%.2f, 버킷 %d, 단계 %d, 완화 %lld)%s\n",
+               t, sec, sec > 0 ? one / sec : 0.0, st.buckets, st.phases, st.relax,
+               same ? "" : "  [ERR] 결과 불일치");
+        if (!same) bad = 1;
+        if (t == maxT) break;
+    }
+    set_thread_count(maxT);
+    freeResult(&ref);
+    freeResult(&r);
+    freeWCsr(&G);
+    return bad;
+}
+
+// ========================= 점대점 질의(양방향 Dijkstra, ALT A*) =========================
+
+// 지연 삭제 최소 힙: decrease-key 대신 (키, 정점)을 새로 넣고, 꺼낼 때 낡은 항목을 버린다.
+typedef struct { int key; int v; } HeapItem;
+
+typedef struct {
+    HeapItem* a;
+    int size, cap;
+} LazyHeap;
+
+static void lhPush(LazyHeap* h, int key, int v) {
+    if (h->size == h->cap) {
+        h->cap = h->cap ? h->cap * 2 : 256;
+        h->a = (HeapItem*)realloc(h->a, (size_t)h->cap * sizeof(HeapItem));
+        if (!h->a) { perror("realloc"); exit(1); }
+    }
+    int i = h->size++;
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (h->a[p].key <= key) break;
+        h->a[i] = h->a[p];
+        i = p;
+    }
+    h->a[i].key = key;
+    h->a[i].v = v;
+}
+
+static HeapItem lhPop(LazyHeap* h) {
+    HeapItem top = h->a[0];
+    HeapItem last = h->a[--h->size];
+    int i = 0;
+    for (;;) {
+        int l = 2 * i + 1, best = l;
+        if (l >= h->size) break;
+        if (l + 1 < h->size && h->a[l + 1].key < h->a[l].key) best = l + 1;
+        if (h->a[best].key >= last.key) break;
+        h->a[i] = h->a[best];
+        i = best;
+    }
+    if (h->size > 0) h->a[i] = last;
+    return top;
+}
+
+// 질의 간에 재사용하는 작업 공간. dist/par는 seen[v] == ver일 때만 유효하고,
+// done[v] == ver이면 확정된 정점이다. 질의마다 ver만 올리므로 O(N) 초기화가 없다.
+// 방향 0 = 출발점에서 정방향, 1 = 도착점에서 역방향(무방향 그래프라 같은 CSR을 쓴다).
+typedef struct {
+    const WCsr* G;
+    unsigned ver;
+    unsigned* seen[2];
+    unsigned* done[2];
+    int* dist[2];
+    int* par[2];
+    LazyHeap heap[2];
+    int L;              // 랜드마크 수
+    int* lm;            // lm[v * L + l] = 랜드마크 l에서 v까지 거리(정점별로 모아 캐시 한 줄에서 읽음)
+    long long settled;  // 마지막 질의에서 확정한 정점 수
+} P2pEngine;
+
+void initP2p(P2pEngine* E, const WCsr* G) {
+    int n = G->n;
+    memset(E, 0, sizeof(*E));
+    E->G = G;
+    for (int d = 0; d < 2; ++d) {
+        E->seen[d] = (unsigned*)calloc((size_t)n, sizeof(unsigned));
+        E->done[d] = (unsigned*)calloc((size_t)n, sizeof(unsigned));
+        E->dist[d] = (int*)malloc((size_t)n * sizeof(int));
+        E->par[d] = (int*)malloc((size_t)n * sizeof(int));
+        if (!E->seen[d] || !E->done[d] || !E->dist[d] || !E->par[d]) { perror("malloc"); exit(1); }
+    }
+}
+
+void freeP2p(P2pEngine* E) {
+    for (int d = 0; d < 2; ++d) {
+        free(E->seen[d]);
+        free(E->done[d]);
+        free(E->dist[d]);
+        free(E->par[d]);
+        free(E->heap[d].a);
+    }
+    free(E->lm);
+    memset(E, 0, sizeof(*E));
+}
+
+// 새 질의 시작: 버전을 올리고, 한 바퀴 돌아 0이 되면 그때만 표식 배열을 비운다.
+static void p2pBegin(P2pEngine* E) {
+    if (++E->ver == 0) {
+        for (int d = 0; d < 2; ++d) {
+            memset(E->seen[d], 0, (size_t)E->G->n * sizeof(unsigned));
+            memset(E->done[d], 0, (size_t)E->G->n * sizeof(unsigned));
+        }
+        E->ver = 1;
+    }
+    E->heap[0].size = E->heap[1].size = 0;
+    E->settled = 0;
+}
+
+static inline int p2pDist(const P2pEngine* E, int d, int v) {
+    return E->seen[d][v] == E->ver ? E->dist[d][v] : INF;
+}
+
+static inline bool p2pRelax(P2pEngine* E, int d, int v, int nd, int u) {
+    if (E->seen[d][v] == E->ver && E->dist[d][v] <= nd) return false;
+    E->seen[d][v] = E->ver;
+    E->dist[d][v] = nd;
+    E->par[d][v] = u;
+    return true;
+}
+
+// 만나는 정점 meet를 기준으로 s -> meet(정방향 부모), meet -> t(역방향 부모) 경로를 이어 붙인다.
+static int p2pPath(const P2pEngine* E, int s, int t, int meet, int* path) {
+    int len = 0;
+    for (int v = meet; ; v = E->par[0][v]) {
+        path[len++] = v;
+        if (v == s) break;
+    }
+    for (int i = 0; i < len / 2; ++i) {
+        int tmp = path[i];
+        path[i] = path[len - 1 - i];
+        path[len - 1 - i] = tmp;
+    }
+    for (int v = meet; v != t; ) {
+        v = E->par[1][v];
+        path[len++] = v;
+    }
+    return len;
+}
+
+// 양방향 Dijkstra. 두 힙 중 최솟값이 작은 쪽을 한 단계씩 진행하고, 간선을 완화할 때 반대편에서
+// 이미 본 정점이면 mu = min(mu, d_s(u) + w + d_t(v))로 갱신한다.
+// 종료 조건: top_s + top_t >= mu (어느 쪽 힙에서 꺼낸 키 합도 mu보다 작은 경로를 만들 수 없음).
+// 반환: 거리(도달 불가면 INF). path가 NULL이 아니면 경로를 채우고 *len에 길이.
+int p2pBidirectional(P2pEngine* E, int s, int t, int* path, int* len) {
+    const WCsr* G = E->G;
+    p2pBegin(E);
+    if (len) *len = 0;
+    p2pRelax(E, 0, s, 0, -1);
+    p2pRelax(E, 1, t, 0, -1);
+    lhPush(&E->heap[0], 0, s);
+    lhPush(&E->heap[1], 0, t);
+    int mu = s == t ? 0 : INF, meet = s == t ? s : -1;
+
+    while (E->heap[0].size > 0 && E->heap[1].size > 0) {
+        if (E->heap[0].a[0].key + E->heap[1].a[0].key >= mu) break;
+        int d = E->heap[0].a[0].key <= E->heap[1].a[0].key ? 0 : 1;
+        HeapItem it = lhPop(&E->heap[d]);
+        int u = it.v;
+        if (E->done[d][u] == E->ver || it.key != E->dist[d][u]) continue;
+        E->done[d][u] = E->ver;
+        E->settled++;
+        for (size_t k = G->off[u]; k < G->off[u + 1]; ++k) {
+            int v = G->adj[k];
+            int nd = it.key + G->w[k];
+            if (p2pRelax(E, d, v, nd, u)) lhPush(&E->heap[d], nd, v);
+            int other = p2pDist(E, 1 - d, v);
+            if (other < INF && nd + other < mu) {
+                mu = nd + other;
+                meet = v;
+            }
+        }
+    }
+    if (meet >= 0 && path && len) *len = p2pPath(E, s, t, meet, path);
+    return mu;
+}
+
+// ALT 하한: 삼각 부등식으로 |d(l, t) - d(l, v)| <= d(v, t). 랜드마크 중 최댓값(일관된 포텐셜).
+static inline int altBound(const P2pEngine* E, int v, int t) {
+    const int* lv = E->lm + (size_t)v * E->L;
+    const int* lt = E->lm + (size_t)t * E->L;
+    int h = 0;
+    for (int l = 0; l < E->L; ++l) {
+        if (lv[l] >= INF || lt[l] >= INF) continue;
+        int diff = lv[l] > lt[l] ? lv[l] - lt[l] : lt[l] - lv[l];
+        if (diff > h) h = diff;
+    }
+    return h;
+}
+
+// ALT A*: 키 = d(s, v) + h(v). 포텐셜이 일관되므로 t를 꺼내는 순간 최단거리가 확정된다.
+int p2pAlt(P2pEngine* E, int s, int t, int* path, int* len) {
+    const WCsr* G = E->G;
+    p2pBegin(E);
+    if (len) *len = 0;
+    p2pRelax(E, 0, s, 0, -1);
+    lhPush(&E->heap[0], altBound(E, s, t), s);
+    while (E->heap[0].size > 0) {
+        HeapItem it = lhPop(&E->heap[0]);
+        int u = it.v;
+        if (E->done[0][u] == E->ver) continue;
+        int du = E->dist[0][u];
+        if (it.key != du + altBound(E, u, t)) continue;     // 낡은 항목
+        E->done[0][u] = E->ver;
+        E->settled++;
+        if (u == t) {
+            if (path && len) {
+                // 역방향 쪽은 쓰지 않으므로 meet = t, 역방향 부분 길이 0
+                int n = 0;
+                for (int v = t; v != -1; v = E->par[0][v]) path[n++] = v;
+                for (int i = 0; i < n / 2; ++i) {
+                    int tmp = path[i];
+                    path[i] = path[n - 1 - i];
+                    path[n - 1 - i] = tmp;
+                }
+                *len = n;
+            }
+            return du;
+        }
+        for (size_t k = G->off[u]; k < G->off[u + 1]; ++k) {
+            int v = G->adj[k];
+            int nd = du + G->w[k];
+            if (E->done[0][v] != E->ver && p2pRelax(E, 0, v, nd, u))
+                lhPush(&E->heap[0], nd + altBound(E, v, t), v);
+        }
+    }
+    return INF;
+}
+
+// 엔진의 정방향 작업 공간으로 src에서 전체 단일 출발 최단거리(랜드마크 전처리용). out[v]에 거리.
+static void p2pSssp(P2pEngine* E, int src, int* out) {
+    const WCsr* G = E->G;
+    p2pBegin(E);
+    p2pRelax(E, 0, src, 0, -1);
+    lhPush(&E->heap[0], 0, src);
+    while (E->heap[0].size > 0) {
+        HeapItem it = lhPop(&E->heap[0]);
+        int u = it.v;
+        if (it.key != E->dist[0][u] || E->done[0][u] == E->ver) continue;
+        E->done[0][u] = E->ver;
+        for (size_t k = G->off[u]; k < G->off[u + 1]; ++k)
+            if (p2pRelax(E, 0, G->adj[k], it.key + G->w[k], u))
+                lhPush(&E->heap[0], it.key + G->w[k], G->adj[k]);
+    }
+    for (int v = 0; v < G->n; ++v) out[v] = p2pDist(E, 0, v);
+}
+
+// 랜드마크 선택(farthest): 첫 랜드마크는 임의 정점에서 가장 먼 정점, 이후로는 기존 랜드마크들까지
+// 최소 거리가 가장 큰 정점. 각 랜드마크마다 전체 SSSP 한 번.
+void p2pBuildLandmarks(P2pEngine* E, int L) {
+    int n = E->G->n;
+    E->L = L;
+    free(E->lm);
+    E->lm = (int*)malloc((size_t)n * (size_t)L * sizeof(int));
+    int* d = (int*)malloc((size_t)n * sizeof(int));
+    int* minD = (int*)malloc((size_t)n * sizeof(int));
+    if (!E->lm || !d || !minD) { perror("malloc"); exit(1); }
+    p2pSssp(E, randBelow(n), d);
+    int pick = 0;
+    for (int v = 0; v < n; ++v)
+        if (d[v] < INF && d[v] > d[pick]) pick = v;
+    for (int v = 0; v < n; ++v) minD[v] = INF;
+    for (int l = 0; l < L; ++l) {
+        p2pSssp(E, pick, d);
+        int next = pick, best = -1;
+        for (int v = 0; v < n; ++v) {
+            E->lm[(size_t)v * L + l] = d[v];
+            if (d[v] < minD[v]) minD[v] = d[v];
+            if (minD[v] < INF && minD[v] > best) { best = minD[v]; next = v; }
+        }
+        pick = next;
+    }
+    free(d);
+    free(minD);
+}
+
+// 점대점 질의 벤치마크: 무작위 쌍 Q개를 양방향 Dijkstra와 ALT A*로 풀고,
+// 앞쪽 일부 쌍은 전체 Dijkstra + reconstructPath 결과(기존 방식)와 거리/경로 비용을 대조.
+#define P2P_VERIFY 20
+
+static int pathCost(const Graph* g, const int* path, int len) {
+    int acc = 0;
+    for (int i = 0; i + 1 < len; ++i) {
+        const Edge* e = g->head[path[i]];
+        while (e && e->to != path[i + 1]) e = e->next;
+        if (!e) return -1;
+        acc += e->w;
+    }
+    return acc;
+}
+
+static int runP2p(Graph* g, int queries, int L) {
+    int n = g->n;
+    compactGraph(g);
+    WCsr G;
+    buildWCsr(g, &G);
+    P2pEngine E;
+    initP2p(&E, &G);
+    double t0 = now_sec();
+    p2pBuildLandmarks(&E, L);
+    printf("정점 %d, 간선 %d, 최대 가중치 %d, 질의 %d, 랜드마크 %d (전처리 %.3f초)\n",
+           n, g->m, g->maxW, queries, L, now_sec() - t0);
+
+    int* qs = (int*)malloc((size_t)queries * 2 * sizeof(int));
+    int* path = (int*)malloc((size_t)n * sizeof(int));
+    int* rpath = (int*)malloc((size_t)n * sizeof(int));
+    int* ans = (int*)malloc((size_t)queries * sizeof(int));
+    if (!qs || !path || !rpath || !ans) { perror("malloc"); exit(1); }
+    for (int i = 0; i < queries * 2; ++i) qs[i] = randBelow(n);
+
+    // 기존 방식: 출발점 전체 Dijkstra 후 경로 복원
+    int nv = queries < P2P_VERIFY ? queries : P2P_VERIFY;
+    PqKind pq = defaultPq(g);
+    DijkstraResult r;
+    initResult(&r, n);
+    t0 = now_sec();
+    for (int i = 0; i < nv; ++i) {
+        dijkstra(g, qs[2 * i], &r, pq);
+        reconstructPath(qs[2 * i], qs[2 * i + 1], &r, rpath);
+        ans[i] = r.dist[qs[2 * i + 1]];
+    }
+    double full = nv ? (now_sec() - t0) / nv : 0.0;
+    printf("  전체 dijkstra(%s) + 경로 복원 : %10.1f us/질의\n", pqName(pq), full * 1e6);
+
+    int bad = 0;
+    for (int method = 0; method < 2; ++method) {
+        long long settled = 0;
+        t0 = now_sec();
+        for (int i = 0; i < queries; ++i) {
+            int s = qs[2 * i], t = qs[2 * i + 1], len = 0;
+            int d = method == 0 ? p2pBidirectional(&E, s, t, path, &len) : p2pAlt(&E, s, t, path, &len);
+            settled += E.settled;
+            if (i < nv) {
+                int cost = len ? pathCost(g, path, len) : INF;
+                if (d != ans[i] || (d < INF && (cost != d || path[0] != s || path[len - 1] != t))) {
+                    if (!bad) printf("  [ERR] 질의 %d (%d -> %d): 기대 %d, 결과 %d\n", i, s, t, ans[i], d);
+                    bad = 1;
+                }
+            }
+        }
+        double per = queries ? (now_sec() - t0) / queries : 0.0;
+        printf("  %s : %10.1f us/질의 (x%.0f, 평균 확정 정점 %.0f)\n",
+               method == 0 ? "양방향 dijkstra               " : "ALT A*                        ", per * 1e6, per > 0 ? full / per : 0.0,
+               queries ? (double)settled / queries : 0.0);
+    }
+    if (!bad) printf("  검증: 질의 %d개 거리/경로가 전체 dijkstra와 일치\n", nv);
+    freeResult(&r);
+    free(qs);
+    free(path);
+    free(rpath);
+    free(ans);
+    freeP2p(&E);
+    freeWCsr(&G);
+    return bad;
+}
+
+// ========================= 축약 계층(Contraction Hierarchy) =========================
+
+// 전처리: 중요도가 낮은 정점부터 하나씩 축약(제거)하며, 이웃 u, x 사이의 최단경로가 v를 지나야만
+// 하면(증인 탐색으로 더 짧은 우회로를 못 찾으면) 지름길 u-x(가중치 w(u,v)+w(v,x), 중간 정점 v)를 넣는다.
+// 축약 순서가 rank이고, v가 축약될 때 남아 있던 이웃(모두 rank가 더 높음)으로의 간선이 v의 상향 간선.
+// 질의: 출발/도착 양쪽에서 상향 간선만 따라 Dijkstra. 최단경로는 rank가 올라갔다 내려가는 모양이라
+// 두 탐색이 가장 높은 정점에서 만난다. 중간 정점 mid로 지름길을 재귀적으로 풀어 원래 경로를 얻는다.
+// 무작위 그래프처럼 남은 부분이 조밀해지면(지름길이 차수 제곱으로 불어남) 축약을 멈추고 남은 정점을
+// 코어로 둔다. 코어 정점의 간선 리스트에는 코어 이웃이 rank와 관계없이 모두 들어가므로, 질의는 상향
+// 탐색으로 코어 입구까지 간 뒤 코어 안에서 보통의 양방향 Dijkstra(합 기준 종료)를 한다.
+#define CH_WITNESS_SETTLE 500   // 증인 탐색 확정 정점 상한(넘으면 지름길을 넣는 쪽으로 보수적 판단)
+#define CH_SIM_SETTLE 50        // 우선순위 계산용 모의 축약의 상한(근사로 충분)
+#define CH_SIM_HOPS 2           // 모의 축약의 증인 경로 간선 수 상한
+#define CH_WITNESS_HOPS 5       // 실제 축약의 증인 경로 간선 수 상한(코어 직전의 조밀한 부분에서 탐색이 번지지 않게)
+#define CH_CORE_DEGREE 32       // 다음 축약 대상의 차수가 이보다 크면 멈추고 남은 정점을 코어로 둔다
+
+typedef struct { int to; int w; int mid; } ChArc;
+
+typedef struct {
+    ChArc* a;
+    int size, cap;
+} ChList;
+
+// 상향 CSR과 질의 작업 공간(양방향 Dijkstra와 같은 버전 표식 방식)
+typedef struct {
+    int n;
+    size_t m;
+    int core;           // 축약하지 않고 남긴 코어 정점 수(rank가 가장 높은 core개)
+    int* rank;
+    uint64_t* off;
+    int* adj;
+    int* w;
+    int* mid;           // 지름길이면 중간 정점, 원래 간선이면 -1
+    unsigned ver;
+    unsigned* seen[2];
+    int* dist[2];
+    int* par[2];
+    LazyHeap heap[2];
+    LazyHeap coreHeap[2];   // 상향 단계에서 도달한 코어 입구(코어 단계의 시작 힙)
+    int* chain;         // 경로 복원용 임시 배열
+    long long settled;
+} ChGraph;
+
+static void chListPut(ChList* L, int to, int w, int mid) {
+    // 이미 있으면 더 짧을 때만 교체(정점 쌍마다 간선 하나)
+    for (int i = 0; i < L->size; ++i) {
+        if (L->a[i].to == to) {
+            if (w < L->a[i].w) {
+                L->a[i].w = w;
+                L->a[i].mid = mid;
+            }
+            return;
+        }
+    }
+    if (L->size == L->cap) {
+        L->cap = L->cap ? L->cap * 2 : 8;
+        L->a = (ChArc*)realloc(L->a, (size_t)L->cap * sizeof(ChArc));
+        if (!L->a) { perror("realloc"); exit(1); }
+    }
+    L->a[L->size].to = to;
+    L->a[L->size].w = w;
+    L->a[L->size].mid = mid;
+    L->size++;
+}
+
+static void chListRemove(ChList* L, int to) {
+    for (int i = 0; i < L->size; ++i) {
+        if (L->a[i].to == to) {
+            L->a[i] = L->a[--L->size];
+            return;
+        }
+    }
+}
+
+// 축약 중 상태: 남은 그래프의 인접 리스트와 증인 탐색 작업 공간
+typedef struct {
+    int n;
+    ChList* adj;
+    bool* contracted;
+    int* deleted;       // 이미 축약된 이웃 수(우선순위 항: 고르게 축약되도록)
+    int* level;         // 계층 깊이 추정: 축약된 이웃의 level + 1 중 최댓값(질의 탐색 공간을 줄임)
+    unsigned ver;
+    unsigned* seen;
+    int* dist;
+    int* hops;          // 증인 탐색에서 출발점부터의 간선 수
+    unsigned* target;   // target[x] == ver이면 이번 증인 탐색이 거리를 알아야 하는 이웃
+    LazyHeap heap;
+} ChBuild;
+
+// 증인 탐색 시작: 버전을 올리고 표식 배열 초기화(한 바퀴 돌았을 때만)
+static void chWitnessBegin(ChBuild* B) {
+    if (++B->ver == 0) {
+        memset(B->seen, 0, (size_t)B->n * sizeof(unsigned));
+        memset(B->target, 0, (size_t)B->n * sizeof(unsigned));
+        B->ver = 1;
+    }
+}
+
+// u에서 skip을 빼고 limit 이하 거리, maxHops 간선 이내만, 최대 maxSettle개 확정하는 증인 탐색.
+// target으로 표시한 정점 targets개가 모두 확정되면 바로 멈춘다. 어느 상한이든 걸리면 증인을 못 찾은
+// 쪽으로 판단하므로 지름길이 늘 뿐 결과는 정확하다.
+static void chWitness(ChBuild* B, int u, int skip, int limit, int maxSettle, int maxHops, int targets) {
+    B->heap.size = 0;
+    B->seen[u] = B->ver;
+    B->dist[u] = 0;
+    B->hops[u] = 0;
+    lhPush(&B->heap, 0, u);
+    int settled = 0;
+    while (B->heap.size > 0 && settled < maxSettle) {
+        HeapItem it = lhPop(&B->heap);
+        if (it.key != B->dist[it.v]) continue;
+        if (it.key > limit) break;
+        settled++;
+        if (B->target[it.v] == B->ver && --targets == 0) break;
+        if (B->hops[it.v] >= maxHops) continue;
+        const ChList* L = &B->adj[it.v];
+        for (int i = 0; i < L->size; ++i) {
+            int x = L->a[i].to;
+            if (x == skip) continue;
+            int nd = it.key + L->a[i].w;
+            if (nd > limit) continue;
+            if (B->seen[x] != B->ver || nd < B->dist[x]) {
+                B->seen[x] = B->ver;
+                B->dist[x] = nd;
+                B->hops[x] = B->hops[it.v] + 1;
+                lhPush(&B->heap, nd, x);
+            }
+        }
+    }
+}
+
+static inline int chWitnessDist(const ChBuild* B, int x) {
+    return B->seen[x] == B->ver ? B->dist[x] : INF;
+}
+
+// v를 축약할 때 필요한 지름길 수를 세고(apply면 실제로 추가), 반환
+static int chContract(ChBuild* B, int v, int maxSettle, int maxHops, bool apply) {
+    ChList* N = &B->adj[v];
+    int shortcuts = 0;
+    for (int i = 0; i < N->size; ++i) {
+        int u = N->a[i].to, wu = N->a[i].w;
+        if (i + 1 == N->size) break;    // 쌍 (i, j>i)만 보므로 마지막은 할 일 없음
+        chWitnessBegin(B);
+        int maxVia = 0;
+        for (int j = i + 1; j < N->size; ++j) {
+            B->target[N->a[j].to] = B->ver;
+            if (N->a[j].w > maxVia) maxVia = N->a[j].w;
+        }
+        chWitness(B, u, v, wu + maxVia, maxSettle, maxHops, N->size - i - 1);
+        for (int j = i + 1; j < N->size; ++j) {
+            int x = N->a[j].to;
+            int via = wu + N->a[j].w;
+            if (chWitnessDist(B, x) <= via) continue;
+            shortcuts++;
+            if (apply) {
+                chListPut(&B->adj[u], x, via, v);
+                chListPut(&B->adj[x], u, via, v);
+            }
+        }
+    }
+    return shortcuts;
+}
+
+static int chPriority(ChBuild* B, int v) {
+    // 코어로 남을 정점은 모의 축약(차수 제곱 번의 증인 탐색)을 건너뛴다
+    if (B->adj[v].size > CH_CORE_DEGREE) return INT_MAX / 2 + B->adj[v].size;
+    int sc = chContract(B, v, CH_SIM_SETTLE, CH_SIM_HOPS, false);
+    return 2 * (sc - B->adj[v].size) + B->deleted[v] + B->level[v];
+}
+
+// 축약 계층 전처리. 우선순위(간선 차이 + 축약된 이웃 수 + 깊이)는 지연 갱신: 꺼낼 때 다시 계산해서
+// 다음 후보보다 커졌으면 다시 넣는다. 축약한 정점의 이웃은 우선순위를 바로 다시 계산한다.
+void buildCh(const WCsr* G, ChGraph* C, long long* shortcutsOut) {
+    int n = G->n;
+    ChBuild B;
+    memset(&B, 0, sizeof(B));
+    B.n = n;
+    B.adj = (ChList*)calloc((size_t)n, sizeof(ChList));
+    B.contracted = (bool*)calloc((size_t)n, sizeof(bool));
+    B.deleted = (int*)calloc((size_t)n, sizeof(int));
+    B.level = (int*)calloc((size_t)n, sizeof(int));
+    B.seen = (unsigned*)calloc((size_t)n, sizeof(unsigned));
+    B.target = (unsigned*)calloc((size_t)n, sizeof(unsigned));
+    B.dist = (int*)malloc((size_t)n * sizeof(int));
+    B.hops = (int*)malloc((size_t)n * sizeof(int));
+    int* prio = (int*)malloc((size_t)n * sizeof(int));
+    if (!B.adj || !B.contracted || !B.deleted || !B.level || !B.seen || !B.target || !B.dist || !B.hops || !prio) { perror("malloc"); exit(1); }
+    for (int u = 0; u < n; ++u)
+        for (size_t k = G->off[u]; k < G->off[u + 1]; ++k)
+            chListPut(&B.adj[u], G->adj[k], G->w[k], -1);
+
+    memset(C, 0, sizeof(*C));
+    C->n = n;
+    C->rank = (int*)malloc((size_t)n * sizeof(int));
+    C->off = (uint64_t*)malloc(((size_t)n + 1) * sizeof(uint64_t));
+    ChList* up = (ChList*)calloc((size_t)n, sizeof(ChList));  // 축약 시점의 이웃 스냅숏
+    if (!C->rank || !C->off || !up) { perror("malloc"); exit(1); }
+
+    LazyHeap pq = { NULL, 0, 0 };
+    for (int v = 0; v < n; ++v) {
+        prio[v] = chPriority(&B, v);
+        lhPush(&pq, prio[v], v);
+    }
+    long long shortcuts = 0;
+    int order = 0;
+    while (pq.size > 0) {
+        HeapItem it = lhPop(&pq);
+        int v = it.v;
+        if (B.contracted[v] || it.key != prio[v]) continue;
+        if (B.adj[v].size > CH_CORE_DEGREE) {
+            lhPush(&pq, it.key, v);
+            break;
+        }
+        int p = chPriority(&B, v);
+        if (pq.size > 0 && p > pq.a[0].key) {
+            prio[v] = p;
+            lhPush(&pq, p, v);
+            continue;
+        }
+        shortcuts += chContract(&B, v, CH_WITNESS_SETTLE, CH_WITNESS_HOPS, true);
+        B.contracted[v] = true;
+        C->rank[v] = order++;
+        up[v] = B.adj[v];
+        B.adj[v].a = NULL;
+        B.adj[v].size = B.adj[v].cap = 0;
+        for (int i = 0; i < up[v].size; ++i) {
+            int u = up[v].a[i].to;
+            chListRemove(&B.adj[u], v);
+            B.deleted[u]++;
+            if (B.level[v] + 1 > B.level[u]) B.level[u] = B.level[v] + 1;
+        }
+        for (int i = 0; i < up[v].size; ++i) {
+            int u = up[v].a[i].to;
+            prio[u] = chPriority(&B, u);
+            lhPush(&pq, prio[u], u);
+        }
+    }
+
+    // 남은 코어: 축약 없이 순위만 매기고 코어 안 간선을 모두 유지
+    for (int v = 0; v < n; ++v) {
+        if (B.contracted[v]) continue;
+        C->rank[v] = order++;
+        C->core++;
+        up[v] = B.adj[v];
+        B.adj[v].a = NULL;
+        B.adj[v].size = B.adj[v].cap = 0;
+    }
+
+    // 상향 CSR
+    C->off[0] = 0;
+    for (int v = 0; v < n; ++v) C->off[v + 1] = C->off[v] + (uint64_t)up[v].size;
+    C->m = (size_t)C->off[n];
+    C->adj = (int*)malloc((C->m ? C->m : 1) * sizeof(int));
+    C->w = (int*)malloc((C->m ? C->m : 1) * sizeof(int));
+    C->mid = (int*)malloc((C->m ? C->m : 1) * sizeof(int));
+    if (!C->adj || !C->w || !C->mid) { perror("malloc"); exit(1); }
+    for (int v = 0; v < n; ++v) {
+        size_t k = C->off[v];
+        for (int i = 0; i < up[v].size; ++i, ++k) {
+            C->adj[k] = up[v].a[i].to;
+            C->w[k] = up[v].a[i].w;
+            C->mid[k] = up[v].a[i].mid;
+        }
+        free(up[v].a);
+        free(B.adj[v].a);
+    }
+    if (shortcutsOut) *shortcutsOut = shortcuts;
+    free(up);
+    free(pq.a);
+    free(prio);
+    free(B.adj);
+    free(B.contracted);
+    free(B.deleted);
+    free(B.level);
+    free(B.seen);
+    free(B.target);
+    free(B.dist);
+    free(B.hops);
+    free(B.heap.a);
+}
+
+// 질의 작업 공간 할당(전처리 직후나 파일에서 읽은 뒤)
+static void chInitQuery(ChGraph* C) {
+    for (int d = 0; d < 2; ++d) {
+        C->seen[d] = (unsigned*)calloc((size_t)C->n, sizeof(unsigned));
+        C->dist[d] = (int*)malloc((size_t)C->n * sizeof(int));
+        C->par[d] = (int*)malloc((size_t)C->n * sizeof(int));
+        if (!C->seen[d] || !C->dist[d] || !C->par[d]) { perror("malloc"); exit(1); }
+    }
+    C->chain = (int*)malloc((size_t)C->n * sizeof(int));
+    if (!C->chain) { perror("malloc"); exit(1); }
+    C->ver = 0;
+}
+
+void freeCh(ChGraph* C) {
+    free(C->rank);
+    free(C->off);
+    free(C->adj);
+    free(C->w);
+    free(C->mid);
+    for (int d = 0; d < 2; ++d) {
+        free(C->seen[d]);
+        free(C->dist[d]);
+        free(C->par[d]);
+        free(C->heap[d].a);
+        free(C->coreHeap[d].a);
+    }
+    free(C->chain);
+    memset(C, 0, sizeof(*C));
+}
+
+// 상향 간선 a-b(둘 중 rank 낮은 쪽의 리스트에 있음)의 mid 조회
+static int chMidOf(const ChGraph* C, int a, int b) {
+    int lo = C->rank[a] < C->rank[b] ? a : b, hi = lo == a ? b : a;
+    for (size_t k = C->off[lo]; k < C->off[lo + 1]; ++k)
+        if (C->adj[k] == hi) return C->mid[k];
+    return -2;  // 없음(손상)
+}
+
+// 간선 a-b를 원래 경로로 풀어 path에 a 다음 정점부터 b까지 덧붙인다
+static void chUnpack(const ChGraph* C, int a, int b, int* path, int* len) {
+    int mid = chMidOf(C, a, b);
+    if (mid < 0) {
+        path[(*len)++] = b;
+        return;
+    }
+    chUnpack(C, a, mid, path, len);
+    chUnpack(C, mid, b, path, len);
+}
+
+// 코어 정점 u를 d 방향으로 펼친다(코어 단계). 코어 리스트에는 코어 이웃만 있다.
+static void chRelaxCore(ChGraph* C, int d, int u, int key, unsigned ver) {
+    for (size_t k = C->off[u]; k < C->off[u + 1]; ++k) {
+        int v = C->adj[k];
+        int nd = key + C->w[k];
+        if (C->seen[d][v] != ver || nd < C->dist[d][v]) {
+            C->seen[d][v] = ver;
+            C->dist[d][v] = nd;
+            C->par[d][v] = u;
+            lhPush(&C->coreHeap[d], nd, v);
+        }
+    }
+}
+
+// 두 단계 질의.
+// 1) 양방향 상향 탐색: 각 방향은 힙 최솟값이 mu 이상이면 멈춘다(상향 탐색은 서로 만나도 바로 멈출 수
+//    없음). 코어 정점은 펼치지 않고 확정 거리로 coreHeap에 넘긴다.
+// 2) 코어 안 양방향 Dijkstra: 코어 입구들을 다중 출발점으로 삼는 보통의 양방향 탐색이라 두 힙 최솟값의
+//    합이 mu 이상이면 멈춰도 정확하다. 코어가 커도 한쪽이 mu 반경 전체를 훑지 않는다.
+int chQuery(ChGraph* C, int s, int t, int* path, int* len) {
+    if (++C->ver == 0) {
+        for (int d = 0; d < 2; ++d) memset(C->seen[d], 0, (size_t)C->n * sizeof(unsigned));
+        C->ver = 1;
+    }
+    unsigned ver = C->ver;
+    int coreRank = C->n - C->core;
+    C->settled = 0;
+    int src[2] = { s, t };
+    for (int d = 0; d < 2; ++d) {
+        C->heap[d].size = 0;
+        C->coreHeap[d].size = 0;
+        C->seen[d][src[d]] = ver;
+        C->dist[d][src[d]] = 0;
+        C->par[d][src[d]] = -1;
+        lhPush(&C->heap[d], 0, src[d]);
+    }
+    int mu = INF, meet = -1;
+    for (;;) {
+        bool live0 = C->heap[0].size > 0 && C->heap[0].a[0].key < mu;
+        bool live1 = C->heap[1].size > 0 && C->heap[1].a[0].key < mu;
+        if (!live0 && !live1) break;
+        int d = live0 && (!live1 || C->heap[0].a[0].key <= C->heap[1].a[0].key) ? 0 : 1;
+        HeapItem it = lhPop(&C->heap[d]);
+        int u = it.v;
+        if (it.key != C->dist[d][u]) continue;
+        C->settled++;
+        if (C->seen[1 - d][u] == ver && it.key + C->dist[1 - d][u] < mu) {
+            mu = it.key + C->dist[1 - d][u];
+            meet = u;
+        }
+        if (C->rank[u] >= coreRank) {
+            lhPush(&C->coreHeap[d], it.key, u);
+            continue;
+        }
+        // stall-on-demand: 더 높은 이웃 x를 거쳐 내려오는 편이 더 짧으면 u는 상향 최단경로 위에
+        // 있지 않으므로 간선을 펼치지 않는다(이 탐색 공간을 크게 줄임)
+        bool stalled = false;
+        for (size_t k = C->off[u]; k < C->off[u + 1]; ++k) {
+            int x = C->adj[k];
+            if (C->seen[d][x] == ver && C->dist[d][x] + C->w[k] < it.key) {
+                stalled = true;
+                break;
+            }
+        }
+        if (stalled) continue;
+        for (size_t k = C->off[u]; k < C->off[u + 1]; ++k) {
+            int v = C->adj[k];
+            int nd = it.key + C->w[k];
+            if (C->seen[d][v] != ver || nd < C->dist[d][v]) {
+                C->seen[d][v] = ver;
+                C->dist[d][v] = nd;
+                C->par[d][v] = u;
+                lhPush(&C->heap[d], nd, v);
+            }
+        }
+    }
+    // 코어 단계: 코어 입구는 상향 단계에서 이미 확정돼 seen에 들어 있으므로 같은 만남 검사를 그대로 쓴다.
+    // 상향 단계가 코어 입구로 넘긴 거리도 확정이라, 다시 꺼낼 때는 mu만 갱신하고 펼친다.
+    while (C->coreHeap[0].size > 0 && C->coreHeap[1].size > 0
+           && (long long)C->coreHeap[0].a[0].key + C->coreHeap[1].a[0].key < mu) {
+        int d = C->coreHeap[0].a[0].key <= C->coreHeap[1].a[0].key ? 0 : 1;
+        HeapItem it = lhPop(&C->coreHeap[d]);
+        int u = it.v;
+        if (it.key != C->dist[d][u]) continue;
+        C->settled++;
+        if (C->seen[1 - d][u] == ver && it.key + C->dist[1 - d][u] < mu) {
+            mu = it.key + C->dist[1 - d][u];
+            meet = u;
+        }
+        chRelaxCore(C, d, u, it.key, ver);
+    }
+    if (len) *len = 0;
+    if (meet >= 0 && path && len) {
+        // s -> meet: 정방향 부모 사슬(meet ... s)을 chain에 모아 뒤에서부터 각 간선을 풀어 쓴다
+        int k = 0;
+        for (int v = meet; v != -1; v = C->par[0][v]) C->chain[k++] = v;
+        int out = 0;
+        path[out++] = s;
+        for (int i = k - 1; i > 0; --i) chUnpack(C, C->chain[i], C->chain[i - 1], path, &out);
+        // meet -> t: 역방향 부모를 따라가며 그대로 풀어 쓴다
+        for (int v = meet; C->par[1][v] != -1; v = C->par[1][v]) chUnpack(C, v, C->par[1][v], path, &out);
+        *len = out;
+    }
+    return mu;
+}
+
+// 축약 계층 파일(버전 1): 헤더 32바이트(코어 정점 수 포함) 뒤에 rank[n], off[n+1](uint64), adj[m], w[m], mid[m].
+// graph_file.h와 같이 쓰는 기계의 바이트 순서를 따른다.
+#define CH_MAGIC "DSHWCH"
+#define CH_VERSION 1u
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t core;
+    uint64_t n;
+    uint64_t m;
+} ChFileHeader;
+
+bool saveCh(const ChGraph* C, const char* path) {
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        perror("ch file open");
+        return false;
+    }
+    ChFileHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CH_MAGIC, sizeof(CH_MAGIC));
+    h.version = CH_VERSION;
+    h.core = (uint32_t)C->core;
+    h.n = (uint64_t)C->n;
+    h.m = (uint64_t)C->m;
+    size_t n = (size_t)C->n, m = C->m;
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1
+           && fwrite(C->rank, sizeof(int), n, fp) == n
+           && fwrite(C->off, sizeof(uint64_t), n + 1, fp) == n + 1
+           && fwrite(C->adj, sizeof(int), m, fp) == m
+           && fwrite(C->w, sizeof(int), m, fp) == m
+           && fwrite(C->mid, sizeof(int), m, fp) == m;
+    if (fclose(fp) != 0) ok = false;
+    if (!ok) fprintf(stderr, "[ERR] 축약 계층 파일 쓰기 실패: %s\n", path);
+    return ok;
+}
+
+// 파일에서 읽어 질의 작업 공간까지 준비. 헤더와 CSR 범위를 검증한다.
+bool loadCh(ChGraph* C, const char* path) {
+    memset(C, 0, sizeof(*C));
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        perror("ch file open");
+        return false;
+    }
+    ChFileHeader h;
+    const char* err = NULL;
+    if (fread(&h, sizeof(h), 1, fp) != 1 || memcmp(h.magic, CH_MAGIC, sizeof(CH_MAGIC)) != 0)
+        err = "형식이 아님";
+    else if (h.version != CH_VERSION)
+        err = "지원하지 않는 버전";
+    else if (h.n == 0 || h.n > (uint64_t)INT_MAX || h.m > (uint64_t)INT_MAX * 4ull || h.core > h.n)
+        err = "크기 범위 오류";
+    if (!err) {
+        size_t n = (size_t)h.n, m = (size_t)h.m;
+        C->n = (int)n;
+        C->m = m;
+        C->core = (int)h.core;
+        C->rank = (int*)malloc(n * sizeof(int));
+        C->off = (uint64_t*)malloc((n + 1) * sizeof(uint64_t));
+        C->adj = (int*)malloc((m ? m : 1) * sizeof(int));
+        C->w = (int*)malloc((m ? m : 1) * sizeof(int));
+        C->mid = (int*)malloc((m ? m : 1) * sizeof(int));
+        if (!C->rank || !C->off || !C->adj || !C->w || !C->mid) { perror("malloc"); exit(1); }
+        if (fread(C->rank, sizeof(int), n, fp) != n
+            || fread(C->off, sizeof(uint64_t), n + 1, fp) != n + 1
+            || fread(C->adj, sizeof(int), m, fp) != m
+            || fread(C->w, sizeof(int), m, fp) != m
+            || fread(C->mid, sizeof(int), m, fp) != m)
+            err = "파일 길이 부족";
+        else if (C->off[0] != 0 || C->off[n] != m)
+            err = "오프셋 손상";
+        for (size_t v = 0; v < n && !err; ++v) {
+            if (C->off[v] > C->off[v + 1] || C->rank[v] < 0 || C->rank[v] >= (int)n) err = "오프셋/순위 손상";
+        }
+        // 지름길의 mid는 두 끝점보다 rank가 낮아야 chUnpack의 재귀가 끝난다(순환 mid 방지)
+        for (size_t v = 0; v < n && !err; ++v) {
+            for (uint64_t k = C->off[v]; k < C->off[v + 1] && !err; ++k) {
+                int x = C->adj[k], mid = C->mid[k];
+                if (x < 0 || x >= (int)n || mid < -1 || mid >= (int)n) err = "간선 손상";
+                else if (mid >= 0 && (C->rank[mid] >= C->rank[v] || C->rank[mid] >= C->rank[x]))
+                    err = "지름길 중간 정점 순위 손상";
+            }
+        }
+    }
+    fclose(fp);
+    if (err) {
+        fprintf(stderr, "[ERR] 축약 계층 파일 %s: %s\n", path, err);
+        freeCh(C);
+        return false;
+    }
+    chInitQuery(C);
+    return true;
+}
+
+// 전처리 시간, 지름길 수, 질의 지연(양방향 Dijkstra 대비)과 정확성 검증. file이 있으면 저장 후
+// 다시 읽어 들인 계층으로 질의한다.
+#define CH_VERIFY 200
+
+static int runCh(Graph* g, int queries, const char* file) {
+    int n = g->n;
+    compactGraph(g);
+    WCsr G;
+    buildWCsr(g, &G);
+    ChGraph C;
+    long long shortcuts = 0;
+    double t0 = now_sec();
+    buildCh(&G, &C, &shortcuts);
+    double pre = now_sec() - t0;
+    printf("정점 %d, 간선 %d, 최대 가중치 %d\n", n, g->m, g->maxW);
+    printf("  전처리 %.3f초, 지름길 %lld개, 상향 간선 %zu개, 코어 정점 %d개\n", pre, shortcuts, C.m, C.core);
+    if (file) {
+        if (!saveCh(&C, file)) {
+            freeCh(&C);
+            freeWCsr(&G);
+            return 1;
+        }
+        freeCh(&C);
+        t0 = now_sec();
+        if (!loadCh(&C, file)) {
+            freeWCsr(&G);
+            return 1;
+        }
+        printf("  %s 저장 후 다시 읽음 (%.3f초)\n", file, now_sec() - t0);
+    } else {
+        chInitQuery(&C);
+    }
+
+    int* qs = (int*)malloc((size_t)queries * 2 * sizeof(int));
+    int* ans = (int*)malloc((size_t)queries * sizeof(int));
+    int* path = (int*)malloc((size_t)n * sizeof(int));
+    if (!qs || !ans || !path) { perror("malloc"); exit(1); }
+    for (int i = 0; i < queries * 2; ++i) qs[i] = randBelow(n);
+
+    // 기준: 양방향 Dijkstra(점대점 엔진)
+    P2pEngine E;
+    initP2p(&E, &G);
+    int nv = queries < CH_VERIFY ? queries : CH_VERIFY;
+    t0 = now_sec();
+    for (int i = 0; i < nv; ++i) ans[i] = p2pBidirectional(&E, qs[2 * i], qs[2 * i + 1], NULL, NULL);
+    double base = nv ? (now_sec() - t0) / nv : 0.0;
+    freeP2p(&E);
+
+    int bad = 0;
+    long long settled = 0;
+    t0 = now_sec();
+    for (int i = 0; i < queries; ++i) {
+        int d = chQuery(&C, qs[2 * i], qs[2 * i + 1], NULL, NULL);
+        settled += C.settled;
+        if (i < nv && d != ans[i]) {
+            if (!bad) printf("  [ERR] 질의 %d (%d -> %d): 기대 %d, 결과 %d\n", i, qs[2 * i], qs[2 * i + 1], ans[i], d);
+            bad = 1;
+        }
+    }
+    double per = queries ? (now_sec() - t0) / queries : 0.0;
+    // 경로 풀기까지 포함한 지연과 경로 비용 검증
+    t0 = now_sec();
+    for (int i = 0; i < nv && !bad; ++i) {
+        int len = 0;
+        int d = chQuery(&C, qs[2 * i], qs[2 * i + 1], path, &len);
+        if (d < INF && (len == 0 || path[0] != qs[2 * i] || path[len - 1] != qs[2 * i + 1]
+                        || pathCost(g, path, len) != d)) {
+            printf("  [ERR] 질의 %d 경로가 잘못되었습니다\n", i);
+            bad = 1;
+        }
+    }
+    double perPath = nv ? (now_sec() - t0) / nv : 0.0;
+    printf("  양방향 dijkstra : %10.1f us/질의\n", base * 1e6);
+    printf("  CH 거리 질의    : %10.2f us/질의 (x%.1f, 평균 확정 정점 %.0f)\n",
+           per * 1e6, per > 0 ? base / per : 0.0, queries ? (double)settled / queries : 0.0);
+    printf("  CH 경로 포함    : %10.2f us/질의\n", perPath * 1e6);
+    // 계층이 없는 그래프(무작위 그래프 등)는 코어가 커지고 상향 탐색 공간도 넓어 기준보다 느릴 수 있다
+    if (per > base)
+        printf("  [WARN] CH가 양방향 dijkstra보다 %.1f배 느림(코어 정점 %.0f%%): 이 그래프에는 p2p 엔진이 낫다\n",
+               base > 0 ? per / base : 0.0, n ? 100.0 * C.core / n : 0.0);
+    if (!bad) printf("  검증: 질의 %d개 거리와 풀어 쓴 경로 비용이 일치\n", nv);
+    free(qs);
+    free(ans);
+    free(path);
+    freeCh(&C);
+    freeWCsr(&G);
+    return bad;
+}
+
+// ========================= 동적 SSSP(간선 변경 묶음 후 부분 복구) =========================
+
+// 간선 변경 하나: w < 0이면 삭제, 간선이 없으면 삽입, 있으면 가중치 변경
+typedef struct { int u, v, w; } EdgeUpdate;
+
+#define DYN_FALLBACK_RATIO 0.25     // 영향 영역이 정점의 이 비율을 넘으면 전체 재계산
+
+// 기존 DijkstraResult(거리 + 최단경로 트리)를 유지하며 간선 변경을 반영한다.
+// 트리의 자식 목록(첫 자식/형제 이중 연결)을 함께 관리해서 부분 트리 탐색이 O(부분 트리 크기).
+typedef struct {
+    int src;
+    DijkstraResult r;
+    int* firstChild;
+    int* nextSib;
+    int* prevSib;
+    unsigned ver;
+    unsigned* affected;     // affected[v] == ver이면 이번 묶음에서 영향받은 정점
+    LazyHeap heap;
+    IntVec list;
+    IntVec stack;
+    PqKind pq;              // 전체 재계산에 쓸 큐
+} DynSssp;
+
+typedef struct {
+    int affected;           // 거리를 버리고 다시 계산한 정점 수
+    int pushed;             // 복구 Dijkstra에서 꺼낸 정점 수
+    bool fallback;          // 전체 재계산으로 넘어갔는지
+} DynStats;
+
+static void dynLink(DynSssp* D, int v, int p) {
+    D->r.parent[v] = p;
+    if (p < 0) return;
+    D->prevSib[v] = -1;
+    D->nextSib[v] = D->firstChild[p];
+    if (D->firstChild[p] >= 0) D->prevSib[D->firstChild[p]] = v;
+    D->firstChild[p] = v;
+}
+
+static void dynUnlink(DynSssp* D, int v) {
+    int p = D->r.parent[v];
+    if (p < 0) return;
+    if (D->prevSib[v] >= 0) D->nextSib[D->prevSib[v]] = D->nextSib[v];
+    else D->firstChild[p] = D->nextSib[v];
+    if (D->nextSib[v] >= 0) D->prevSib[D->nextSib[v]] = D->prevSib[v];
+    D->r.parent[v] = -1;
+}
+
+// 전체 Dijkstra 후 자식 목록 재구성
+static void dynRecompute(const Graph* g, DynSssp* D) {
+    int n = g->n;
+    dijkstra(g, D->src, &D->r, D->pq);
+    for (int v = 0; v < n; ++v) D->firstChild[v] = -1;
+    for (int v = 0; v < n; ++v) {
+        int p = D->r.parent[v];
+        D->r.parent[v] = -1;
+        dynLink(D, v, p);
+    }
+}
+
+void initDyn(const Graph* g, DynSssp* D, int src, PqKind pq) {
+    int n = g->n;
+    memset(D, 0, sizeof(*D));
+    D->src = src;
+    D->pq = pq;
+    initResult(&D->r, n);
+    D->firstChild = (int*)malloc((size_t)n * sizeof(int));
+    D->nextSib = (int*)malloc((size_t)n * sizeof(int));
+    D->prevSib = (int*)malloc((size_t)n * sizeof(int));
+    D->affected = (unsigned*)calloc((size_t)n, sizeof(unsigned));
+    if (!D->firstChild || !D->nextSib || !D->prevSib || !D->affected) { perror("malloc"); exit(1); }
+    dynRecompute(g, D);
+}
+
+void freeDyn(DynSssp* D) {
+    freeResult(&D->r);
+    free(D->firstChild);
+    free(D->nextSib);
+    free(D->prevSib);
+    free(D->affected);
+    free(D->heap.a);
+    free(D->list.a);
+    free(D->stack.a);
+    memset(D, 0, sizeof(*D));
+}
+
+static inline void dynRelax(DynSssp* D, int v, int nd, int p) {
+    if (nd >= D->r.dist[v]) return;
+    D->r.dist[v] = nd;
+    if (D->r.parent[v] != p) {
+        dynUnlink(D, v);
+        dynLink(D, v, p);
+    }
+    lhPush(&D->heap, nd, v);
+}
+
+// 간선 변경 묶음을 그래프에 적용하고 D를 복구한다(Ramalingam-Reps 방식).
+//  1) 가중치가 늘거나 삭제된 간선이 트리 간선이면 그 자식의 부분 트리 전체가 영향 영역.
+//     (영역 밖 정점은 트리 경로가 그대로라 기존 거리가 여전히 달성 가능한 상한이다)
+//  2) 영향 영역의 거리를 버리고, 영역 밖 이웃에서 오는 최선 후보로 다시 시작해 힙에 넣는다.
+//  3) 줄어들거나 새로 생긴 간선은 양 끝에서 완화를 시도해 힙에 넣는다.
+//  4) 힙에서 Dijkstra를 돌리면 영역 내부 재계산과 감소 전파가 한 번에 끝난다.
+// 영향 영역이 DYN_FALLBACK_RATIO * n을 넘으면 전체 재계산이 더 싸므로 그쪽으로 간다.
+void dynApplyBatch(Graph* g, DynSssp* D, const EdgeUpdate* ups, int count, DynStats* st) {
+    int n = g->n;
+    int* dist = D->r.dist;
+    int* parent = D->r.parent;
+    int limit = (int)(DYN_FALLBACK_RATIO * n);
+    if (++D->ver == 0) {
+        memset(D->affected, 0, (size_t)n * sizeof(unsigned));
+        D->ver = 1;
+    }
+    D->list.size = 0;
+    D->heap.size = 0;
+    st->affected = st->pushed = 0;
+    st->fallback = false;
+
+    // 1) 그래프 변경 + 영향 영역 표시. 감소 간선은 ups 인덱스를 모아 둔다.
+    IntVec dec = { NULL, 0, 0 };
+    bool tooBig = false;
+    for (int i = 0; i < count; ++i) {
+        int u = ups[i].u, v = ups[i].v, w = ups[i].w;
+        if (!validV(g, u) || !validV(g, v) || u == v) continue;
+        Edge* e = findEdge(g, u, v);
+        int oldW = e ? e->w : INF;
+        if (w < 0) {
+            if (!e) continue;
+            removeEdge(g, u, v);
+        } else if (e) {
+            setEdgeWeight(g, u, v, w);
+        } else {
+            addEdge(g, u, v, w);
+        }
+        int newW = w < 0 ? INF : w;
+        if (newW < oldW) ivPush(&dec, i);
+        if (newW <= oldW || tooBig) continue;
+        int child = parent[v] == u ? v : parent[u] == v ? u : -1;
+        if (child < 0 || D->affected[child] == D->ver) continue;
+        // 부분 트리 수집(자식 목록 DFS)
+        D->stack.size = 0;
+        ivPush(&D->stack, child);
+        while (D->stack.size > 0 && !tooBig) {
+            int x = D->stack.a[--D->stack.size];
+            if (D->affected[x] == D->ver) continue;
+            D->affected[x] = D->ver;
+            ivPush(&D->list, x);
+            if (D->list.size > limit) tooBig = true;
+            for (int c = D->firstChild[x]; c >= 0; c = D->nextSib[c]) ivPush(&D->stack, c);
+        }
+    }
+    if (tooBig) {
+        dynRecompute(g, D);
+        st->affected = n;
+        st->fallback = true;
+        free(dec.a);
+        return;
+    }
+
+    // 2) 영향 영역 초기화: 트리에서 떼고 거리 INF, 영역 밖 이웃의 최선 후보로 다시 시작
+    for (int i = 0; i < D->list.size; ++i) {
+        int x = D->list.a[i];
+        dynUnlink(D, x);
+        dist[x] = INF;
+    }
+    for (int i = 0; i < D->list.size; ++i) {
+        int x = D->list.a[i];
+        int best = INF, bp = -1;
+        for (const Edge* e = g->head[x]; e; e = e->next) {
+            int y = e->to;
+            if (D->affected[y] == D->ver || dist[y] >= INF) continue;
+            if (dist[y] + e->w < best) {
+                best = dist[y] + e->w;
+                bp = y;
+            }
+        }
+        if (bp >= 0) dynRelax(D, x, best, bp);
+    }
+    st->affected = D->list.size;
+
+    // 3) 감소/삽입 간선 양 끝 완화
+    for (int i = 0; i < dec.size; ++i) {
+        const EdgeUpdate* up = &ups[dec.a[i]];
+        Edge* e = findEdge(g, up->u, up->v);
+        if (!e) continue;   // 같은 묶음 안에서 나중에 삭제됨
+        if (dist[up->u] < INF) dynRelax(D, up->v, dist[up->u] + e->w, up->u);
+        if (dist[up->v] < INF) dynRelax(D, up->u, dist[up->v] + e->w, up->v);
+    }
+    free(dec.a);
+
+    // 4) 힙 Dijkstra로 전파
+    while (D->heap.size > 0) {
+        HeapItem it = lhPop(&D->heap);
+        int x = it.v;
+        if (it.key != dist[x]) continue;
+        st->pushed++;
+        for (const Edge* e = g->head[x]; e; e = e->next)
+            dynRelax(D, e->to, it.key + e->w, x);
+    }
+}
+
+// 동적 SSSP 벤치마크: 무작위 변경 묶음(가중치 증감/삭제/삽입 섞어서)을 반복 적용하며
+// 부분 복구 시간과 전체 재계산 시간을 비교하고, 매 묶음마다 거리 배열과 트리를 대조한다.
+static int runDyn(Graph* g, int batches, int batchSize) {
+    int n = g->n;
+    PqKind pq = defaultPq(g);
+    int maxW = g->maxW > 0 ? g->maxW : 1;
+    DynSssp D;
+    initDyn(g, &D, 0, pq);
+    DijkstraResult ref;
+    initResult(&ref, n);
+    EdgeUpdate* ups = (EdgeUpdate*)malloc((size_t)batchSize * sizeof(EdgeUpdate));
+    if (!ups) { perror("malloc"); exit(1); }
+    printf("정점 %d, 간선 %d, 최대 가중치 %d, 묶음 %d x 변경 %d\n", n, g->m, maxW, batches, batchSize);
+
+    double repairSec = 0, fullSec = 0;
+    long long affected = 0;
+    int fallbacks = 0, bad = 0;
+    for (int b = 0; b < batches && !bad; ++b) {
+        for (int i = 0; i < batchSize; ++i) {
+            EdgeUpdate* up = &ups[i];
+            int kind = randBelow(4);
+            int u = randBelow(n);
+            const Edge* e = g->head[u];
+            if (kind < 3 && e) {
+                // 기존 간선 하나를 골라 0: 증가, 1: 감소, 2: 삭제
+                int deg = 0;
+                for (const Edge* x = e; x; x = x->next) deg++;
+                for (int k = randBelow(deg); k > 0; --k) e = e->next;
+                up->u = u;
+                up->v = e->to;
+                up->w = kind == 0 ? e->w + 1 + randBelow(maxW)
+                      : kind == 1 ? 1 + randBelow(e->w)
+                      : -1;
+            } else {
+                up->u = u;
+                up->v = randBelow(n);
+                up->w = 1 + randBelow(maxW);
+            }
+        }
+        DynStats st;
+        double t0 = now_sec();
+        dynApplyBatch(g, &D, ups, batchSize, &st);
+        repairSec += now_sec() - t0;
+        affected += st.affected;
+        if (st.fallback) fallbacks++;
+
+        t0 = now_sec();
+        dijkstra(g, 0, &ref, defaultPq(g));
+        fullSec += now_sec() - t0;
+        if (memcmp(ref.dist, D.r.dist, (size_t)n * sizeof(int)) != 0) {
+            printf("  [ERR] 묶음 %d: 거리가 전체 재계산과 다릅니다\n", b);
+            bad = 1;
+        }
+        for (int v = 0; v < n && !bad; ++v) {
+            int p = D.r.parent[v];
+            if (v == 0 || D.r.dist[v] >= INF) continue;
+            const Edge* e = p >= 0 ? findEdge(g, p, v) : NULL;
+            if (!e || D.r.dist[p] + e->w != D.r.dist[v]) {
+                printf("  [ERR] 묶음 %d: 정점 %d의 부모 간선이 최단경로 트리가 아닙니다\n", b, v);
+                bad = 1;
+            }
+        }
+    }
+    printf("  부분 복구   : %10.1f us/묶음 (평균 영향 정점 %.0f, 전체 재계산 전환 %d회)\n",
+           batches ? repairSec / batches * 1e6 : 0.0, batches ? (double)affected / batches : 0.0, fallbacks);
+    printf("  전체 재계산 : %10.1f us/묶음 (x%.1f)\n", batches ? fullSec / batches * 1e6 : 0.0,
+           repairSec > 0 ? fullSec / repairSec : 0.0);
+    if (!bad) printf("  검증: 묶음 %d개 모두 거리/트리가 전체 재계산과 일치\n", batches);
+    free(ups);
+    freeResult(&ref);
+    freeDyn(&D);
+    return bad;
+}
+
+// ========================= 다중 출발 묶음(SIMD 레인 Dijkstra, 비트마스크 BFS) =========================
+
+// 출발점 K개(K = 8 또는 16)를 한꺼번에 진행한다. 정점마다 레인 K개짜리 거리 벡터를 두고
+// 간선 하나를 읽을 때 K개 출발점의 완화를 SIMD min 한 번(AVX2 8레인 x K/8)으로 처리한다.
+// 순서는 델타 스테핑식 버킷: 정점을 "아직 전파하지 않은(dirty) 레인 중 최소 거리"의 버킷에 두고,
+// 버킷 b를 처리할 때 거리 < (b+1)*delta인 dirty 레인을 모아 한 번에 전파한다.
+// delta가 클수록 한 번의 간선 스캔을 공유하는 레인이 늘고, 대신 재완화가 늘어난다.
+#define MS_MAX_LANES 16
+#define MS_BFS_LANES 64     // 비트마스크 BFS: uint64_t 한 워드 = 출발점 64개
+
+typedef struct {
+    int n, lanes;
+    int maxW, delta;
+    int* dist;              // dist[v * lanes + l]
+    uint16_t* dirty;        // 아직 이웃에 전파하지 않은 레인 비트
+    int* inQ;               // 정점이 들어가 있는 (절대) 버킷 번호, 없으면 -1
+    IntVec* bk;             // 원형 버킷: 키 범위가 [cur, cur + maxW/delta + 1]이라 이만큼이면 충분
+    int nbk;
+} MsEngine;
+
+typedef struct {
+    long long pops;         // 버킷에서 꺼내 전파한 횟수(= 인접 리스트 스캔 횟수)
+    long long arcs;         // 읽은 간선 수
+    long long lanes;        // 전파된 (정점, 레인) 쌍 수: 단일 출발이었다면 인접 리스트 스캔 수
+} MsStats;
+
+void initMs(MsEngine* E, int n, int lanes, int maxW, int delta) {
+    memset(E, 0, sizeof(*E));
+    E->n = n;
+    E->lanes = lanes;
+    E->maxW = maxW > 0 ? maxW : 1;
+    E->delta = delta > 0 ? delta : 1;
+    E->nbk = E->maxW / E->delta + 2;
+    E->dist = (int*)malloc((size_t)n * lanes * sizeof(int));
+    E->dirty = (uint16_t*)malloc((size_t)n * sizeof(uint16_t));
+    E->inQ = (int*)malloc((size_t)n * sizeof(int));
+    E->bk = (IntVec*)calloc((size_t)E->nbk, sizeof(IntVec));
+    if (!E->dist || !E->dirty || !E->inQ || !E->bk) { perror("malloc"); exit(1); }
+}
+
+void freeMs(MsEngine* E) {
+    for (int i = 0; i < E->nbk; ++i) free(E->bk[i].a);
+    free(E->bk);
+    free(E->dist);
+    free(E->dirty);
+    free(E->inQ);
+    memset(E, 0, sizeof(*E));
+}
+
+static inline void msPush(MsEngine* E, int v, int key, long long* queued) {
+    int b = key / E->delta;
+    if (E->inQ[v] >= 0 && E->inQ[v] <= b) return;
+    E->inQ[v] = b;
+    ivPush(&E->bk[b % E->nbk], v);
+    (*queued)++;
+}
+
+// 정점 u의 레인 중 active 비트에 해당하는 것만 이웃으로 전파한다.
+// 줄어든 (이웃, 레인)은 dirty로 표시하고 그중 최소 거리 버킷에 이웃을 넣는다.
+static void msRelax(MsEngine* E, const WCsr* G, int u, unsigned active, long long* queued) {
+    int L = E->lanes;
+    const int* du = E->dist + (size_t)u * L;
+#ifdef __AVX2__
+    const __m256i inf = _mm256_set1_epi32(INF);
+    const __m256i sel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i src[MS_MAX_LANES / 8];
+    int nv = L / 8;
+    for (int j = 0; j < nv; ++j) {
+        // 비활성 레인은 INF로 바꿔 두면 INF + w > 어떤 거리이므로 비교에서 자동으로 빠진다
+        __m256i bits = _mm256_set1_epi32((int)(active >> (8 * j)) & 0xFF);
+        __m256i on = _mm256_cmpeq_epi32(_mm256_and_si256(bits, sel), sel);
+        src[j] = _mm256_blendv_epi8(inf, _mm256_loadu_si256((const __m256i*)(du + 8 * j)), on);
+    }
+    for (size_t k = G->off[u]; k < G->off[u + 1]; ++k) {
+        int v = G->adj[k];
+        int* dv = E->dist + (size_t)v * L;
+        __m256i w = _mm256_set1_epi32(G->w[k]);
+        unsigned improved = 0;
+        int key = INF;
+        for (int j = 0; j < nv; ++j) {
+            __m256i nd = _mm256_add_epi32(src[j], w);
+            __m256i cur = _mm256_loadu_si256((const __m256i*)(dv + 8 * j));
+            __m256i lt = _mm256_cmpgt_epi32(cur, nd);
+            unsigned m = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(lt));
+            if (!m) continue;
+            _mm256_storeu_si256((__m256i*)(dv + 8 * j), _mm256_min_epi32(cur, nd));
+            improved |= m << (8 * j);
+            for (unsigned b = m; b; b &= b - 1) {
+                int d = dv[8 * j + __builtin_ctz(b)];
+                if (d < key) key = d;
+            }
+        }
+        if (improved) {
+            E->dirty[v] |= (uint16_t)improved;
+            msPush(E, v, key, queued);
+        }
+    }
+#else
+    for (size_t k = G->off[u]; k < G->off[u + 1]; ++k) {
+        int v = G->adj[k];
+        int* dv = E->dist + (size_t)v * L;
+        int w = G->w[k];
+        unsigned improved = 0;
+        int key = INF;
+        for (unsigned b = active; b; b &= b - 1) {
+            int l = __builtin_ctz(b);
+            int nd = du[l] + w;
+            if (nd < dv[l]) {
+                dv[l] = nd;
+                improved |= 1u << l;
+                if (nd < key) key = nd;
+            }
+        }
+        if (improved) {
+            E->dirty[v] |= (uint16_t)improved;
+            msPush(E, v, key, queued);
+        }
+    }
+#endif
+}
+
+// 출발점 srcs[0..cnt) (cnt <= lanes)에서 동시에 최단거리. 결과는 E->dist의 레인 l.
+void msDijkstra(MsEngine* E, const WCsr* G, const int* srcs, int cnt, MsStats* st) {
+    int n = E->n, L = E->lanes;
+    memset(E->dist, 0x3f, (size_t)n * L * sizeof(int));     // INF == 0x3f3f3f3f
+    memset(E->dirty, 0, (size_t)n * sizeof(uint16_t));
+    for (int v = 0; v < n; ++v) E->inQ[v] = -1;
+    for (int i = 0; i < E->nbk; ++i) E->bk[i].size = 0;
+
+    long long queued = 0;
+    for (int l = 0; l < cnt; ++l) {
+        int s = srcs[l];
+        E->dist[(size_t)s * L + l] = 0;
+        E->dirty[s] |= (uint16_t)(1u << l);
+        msPush(E, s, 0, &queued);
+    }
+    for (int cur = 0; queued > 0; ++cur) {
+        IntVec* B = &E->bk[cur % E->nbk];
+        long long limit = (long long)(cur + 1) * E->delta;
+        // 버킷 안은 FIFO: 같은 버킷으로 다시 들어온 정점은 뒤에 붙고 이번 차례에 함께 처리된다
+        for (int i = 0; i < B->size; ++i) {
+            int u = B->a[i];
+            queued--;
+            if (E->inQ[u] != cur) continue;    // 더 앞 버킷으로 옮겨진 낡은 항목
+            E->inQ[u] = -1;
+            const int* du = E->dist + (size_t)u * L;
+            unsigned active = 0;
+            int rest = INF;
+            for (unsigned b = E->dirty[u]; b; b &= b - 1) {
+                int l = __builtin_ctz(b);
+                if (du[l] < limit) active |= 1u << l;
+                else if (du[l] < rest) rest = du[l];
+            }
+            E->dirty[u] &= (uint16_t)~active;
+            if (E->dirty[u]) msPush(E, u, rest, &queued);
+            if (!active) continue;
+            st->pops++;
+            st->arcs += (long long)(G->off[u + 1] - G->off[u]);
+            st->lanes += __builtin_popcount(active);
+            msRelax(E, G, u, active, &queued);
+        }
+        B->size = 0;
+    }
+}
+
+// 비트마스크 다중 출발 BFS(MS-BFS): seen/visit/next를 정점당 uint64_t로 두고
+// 인접 리스트 한 번 스캔으로 최대 64개 출발점의 프런티어를 함께 넓힌다.
+// 출발점별 도달 정점 수와 거리 합(근접 중심성 재료)만 모은다.
+void msBfs(const WCsr* G, const int* srcs, int cnt, uint64_t* seen, uint64_t* visit, uint64_t* next,
+           long long* reach, long long* sum, long long* arcs) {
+    int n = G->n;
+    memset(seen, 0, (size_t)n * sizeof(uint64_t));
+    memset(visit, 0, (size_t)n * sizeof(uint64_t));
+    memset(next, 0, (size_t)n * sizeof(uint64_t));
+    for (int i = 0; i < cnt; ++i) {
+        seen[srcs[i]] |= 1ull << i;
+        visit[srcs[i]] |= 1ull << i;
+        reach[i] = 1;
+        sum[i] = 0;
+    }
+    for (int level = 1; ; ++level) {
+        bool any = false;
+        for (int u = 0; u < n; ++u) {
+            uint64_t f = visit[u];
+            if (!f) continue;
+            *arcs += (long long)(G->off[u + 1] - G->off[u]);
+            for (size_t k = G->off[u]; k < G->off[u + 1]; ++k) next[G->adj[k]] |= f;
+        }
+        for (int v = 0; v < n; ++v) {
+            uint64_t nw = next[v] & ~seen[v];
+            next[v] = 0;
+            visit[v] = nw;
+            if (!nw) continue;
+            any = true;
+            seen[v] |= nw;
+            for (; nw; nw &= nw - 1) {
+                int i = __builtin_ctzll(nw);
+                reach[i]++;
+                sum[i] += level;
+            }
+        }
+        if (!any) break;
+    }
+}
+
+// 출발점 하나짜리 BFS(대조용). 도달 수와 거리 합, 읽은 간선 수.
+static void bfsOne(const WCsr* G, int s, int* dist, int* queue, long long* reach, long long* sum, long long* arcs) {
+    for (int v = 0; v < G->n; ++v) dist[v] = -1;
+    int qh = 0, qt = 0;
+    dist[s] = 0;
+    queue[qt++] = s;
+    *reach = 0;
+    *sum = 0;
+    while (qh < qt) {
+        int u = queue[qh++];
+        (*reach)++;
+        *sum += dist[u];
+        *arcs += (long long)(G->off[u + 1] - G->off[u]);
+        for (size_t k = G->off[u]; k < G->off[u + 1]; ++k) {
+            int v = G->adj[k];
+            if (dist[v] < 0) {
+                dist[v] = dist[u] + 1;
+                queue[qt++] = v;
+            }
+        }
+    }
+}
+
+// 거리 배열 요약(도달 수, 거리 합, 위치 가중 합): 출발점별 결과를 통째로 들고 있지 않고 대조
+typedef struct { long long reach, sum; uint64_t mix; } DistDigest;
+
+static inline void digestAdd(DistDigest* d, int v, int dist) {
+    if (dist >= INF) return;
+    d->reach++;
+    d->sum += dist;
+    d->mix += (uint64_t)dist * (uint64_t)(v + 1);
+}
+
+// 출발점 S개를 단일 출발 Dijkstra / 레인 묶음으로 각각 풀어 시간·간선 읽기 수를 비교하고,
+// 같은 그래프를 비가중으로 보고 BFS / MS-BFS도 비교한다. 출발점 묶음은 스레드끼리 나눈다.
+static int runMs(Graph* g, int S, int lanes, int delta) {
+    int n = g->n;
+    if (S > n) S = n;
+    compactGraph(g);
+    WCsr G;
+    buildWCsr(g, &G);
+    if (delta <= 0) delta = g->maxW > 0 ? g->maxW : 1;
+    PqKind pq = defaultPq(g);
+    int* srcs = (int*)malloc((size_t)S * sizeof(int));
+    DistDigest* ref = (DistDigest*)calloc((size_t)S, sizeof(DistDigest));
+    DistDigest* got = (DistDigest*)calloc((size_t)S, sizeof(DistDigest));
+    if (!srcs || !ref || !got) { perror("malloc"); exit(1); }
+    // 출발점은 무작위 정점에서 시작한 BFS 순서의 앞쪽 S개. 모든 쌍/중심성 계산을 BFS 순서로
+    // 레인 수만큼씩 묶어 돌리는 경우의 한 구간과 같다(가까운 출발점끼리 거리 파면이 겹쳐 스캔을 공유).
+    {
+        int* order = (int*)malloc((size_t)n * sizeof(int));
+        int* tmp = (int*)malloc((size_t)n * sizeof(int));
+        if (!order || !tmp) { perror("malloc"); exit(1); }
+        long long reach = 0, sum = 0, arcs = 0;
+        bfsOne(&G, randBelow(n), tmp, order, &reach, &sum, &arcs);
+        if (S > reach) S = (int)reach;
+        memcpy(srcs, order, (size_t)S * sizeof(int));
+        free(order);
+        free(tmp);
+    }
+    printf("정점 %d, 간선 %d, 최대 가중치 %d, 출발점 %d, 레인 %d, delta %d, 스레드 %d\n",
+           n, g->m, g->maxW, S, lanes, delta, thread_count());
+
+    long long arcs1 = 0;
+    double t0 = now_sec();
+    #pragma omp parallel reduction(+:arcs1)
+    {
+        DijkstraWork w;
+        DijkstraResult r;
+        initWork(&w, g, pq);
+        initResult(&r, n);
+        #pragma omp for schedule(dynamic, 1)
+        for (int i = 0; i < S; ++i) {
+            dijkstraRun(g, srcs[i], &r, &w);
+            DistDigest d = { 0, 0, 0 };
+            for (int k = 0; k < w.settled; ++k) {
+                int v = w.order[k];
+                digestAdd(&d, v, r.dist[v]);
+                arcs1 += (long long)(G.off[v + 1] - G.off[v]);
+            }
+            ref[i] = d;
+        }
+        freeWork(&w);
+        freeResult(&r);
+    }
+    double single = now_sec() - t0;
+
+    MsStats tot = { 0, 0, 0 };
+    int batches = (S + lanes - 1) / lanes;
+    t0 = now_sec();
+    #pragma omp parallel
+    {
+        MsEngine E;
+        MsStats st = { 0, 0, 0 };
+        initMs(&E, n, lanes, g->maxW, delta);
+        #pragma omp for schedule(dynamic, 1)
+        for (int b = 0; b < batches; ++b) {
+            int base = b * lanes;
+            int cnt = S - base < lanes ? S - base : lanes;
+            msDijkstra(&E, &G, srcs + base, cnt, &st);
+            for (int l = 0; l < cnt; ++l) {
+                DistDigest d = { 0, 0, 0 };
+                for (int v = 0; v < n; ++v) digestAdd(&d, v, E.dist[(size_t)v * lanes + l]);
+                got[base + l] = d;
+            }
+        }
+        #pragma omp critical
+        {
+            tot.pops += st.pops;
+            tot.arcs += st.arcs;
+            tot.lanes += st.lanes;
+        }
+        freeMs(&E);
+    }
+    double batched = now_sec() - t0;
+    int bad = memcmp(ref, got, (size_t)S * sizeof(DistDigest)) != 0;
+    long long reached = 0;     // 단일 출발이라면 정확히 이만큼 (정점, 출발점) 전파
+    for (int i = 0; i < S; ++i) reached += ref[i].reach;
+    printf("  단일 출발 Dijkstra(%s) x %d : %8.3f초, 간선 읽기 %lld\n", pqName(pq), S, single, arcs1);
+    printf("  레인 묶음 %2d개씩          : %8.3f초, 간선 읽기 %lld (x%.2f 감소, 스캔당 레인 %.2f, 재완화 비율 %.2f)%s\n",
+           lanes, batched, tot.arcs, tot.arcs ? (double)arcs1 / tot.arcs : 0.0,
+           tot.pops ? (double)tot.lanes / tot.pops : 0.0,
+           reached > 0 ? (double)tot.lanes / reached : 0.0,
+           bad ? "  [ERR] 결과 불일치" : "");
+    printf("                              속도 x%.2f\n", batched > 0 ? single / batched : 0.0);
+
+    // 비가중 BFS 대조: 같은 출발점, 워드당 64개
+    long long* r1 = (long long*)malloc((size_t)S * 2 * sizeof(long long));
+    long long* r2 = (long long*)malloc((size_t)S * 2 * sizeof(long long));
+    if (!r1 || !r2) { perror("malloc"); exit(1); }
+    long long bfsArcs1 = 0, bfsArcs2 = 0;
+    t0 = now_sec();
+    #pragma omp parallel reduction(+:bfsArcs1)
+    {
+        int* dist = (int*)malloc((size_t)n * sizeof(int));
+        int* queue = (int*)malloc((size_t)n * sizeof(int));
+        if (!dist || !queue) { perror("malloc"); exit(1); }
+        #pragma omp for schedule(dynamic, 1)
+        for (int i = 0; i < S; ++i) bfsOne(&G, srcs[i], dist, queue, &r1[2 * i], &r1[2 * i + 1], &bfsArcs1);
+        free(dist);
+        free(queue);
+    }
+    double bfs1 = now_sec() - t0;
+
+    int words = (S + MS_BFS_LANES - 1) / MS_BFS_LANES;
+    t0 = now_sec();
+    #pragma omp parallel reduction(+:bfsArcs2)
+    {
+        uint64_t* seen = (uint64_t*)malloc((size_t)n * sizeof(uint64_t));
+        uint64_t* visit = (uint64_t*)malloc((size_t)n * sizeof(uint64_t));
+        uint64_t* next = (uint64_t*)malloc((size_t)n * sizeof(uint64_t));
+        long long reach[MS_BFS_LANES], sum[MS_BFS_LANES];
+        if (!seen || !visit || !next) { perror("malloc"); exit(1); }
+        #pragma omp for schedule(dynamic, 1)
+        for (int b = 0; b < words; ++b) {
+            int base = b * MS_BFS_LANES;
+            int cnt = S - base < MS_BFS_LANES ? S - base : MS_BFS_LANES;
+            msBfs(&G, srcs + base, cnt, seen, visit, next, reach, sum, &bfsArcs2);
+            for (int i = 0; i < cnt; ++i) {
+                r2[2 * (base + i)] = reach[i];
+                r2[2 * (base + i) + 1] = sum[i];
+            }
+        }
+        free(seen);
+        free(visit);
+        free(next);
+    }
+    double bfs2 = now_sec() - t0;
+    bool bfsBad = memcmp(r1, r2, (size_t)S * 2 * sizeof(long long)) != 0;
+    printf("  BFS x %d                   : %8.3f초, 간선 읽기 %lld\n", S, bfs1, bfsArcs1);
+    printf("  MS-BFS(비트마스크 %d개씩)  : %8.3f초, 간선 읽기 %lld (x%.2f, 속도 x%.2f)%s\n",
+           MS_BFS_LANES, bfs2, bfsArcs2, bfsArcs2 ? (double)bfsArcs1 / bfsArcs2 : 0.0,
+           bfs2 > 0 ? bfs1 / bfs2 : 0.0, bfsBad ? "  [ERR] 결과 불일치" : "");
+    if (!bad && !bfsBad) printf("  검증: 출발점 %d개 모두 거리 요약이 단일 출발 결과와 일치\n", S);
+
+    free(r1);
+    free(r2);
+    free(srcs);
+    free(ref);
+    free(got);
+    freeWCsr(&G);
+    return bad || bfsBad;
+}
+
+// 작은 그래프: 간선 목록과 모든 쌍(u < v) 최단경로 출력
+static int printAllPairs(const Graph* g, PqKind pq) {
+    int n = g->n;
+    // 생성된 그래프(간선 목록) 출력: u < v만 한 번 출력
+    printf("무작위 무방향 가중 그래프 생성 (정점 수=%d, 간선 수=%d)\n", n, g->m);
+    for (int u = 0; u < n; ++u) {
+        // 방어: head가 NULL일 수도 있음
+        if (g->head[u] == NULL)
+            continue; // NULL인 경우 건너뛰기
+        Edge* e = g->head[u];
+        int guard = n; // 비정상 루프 방지
+        while (e && guard-- > 0) {
+            int v = e->to;
+            if (validV(g, v)) {
+                if (u < v) printf("간선 %2d - %2d, 가중치=%d\n", u, v, e->w);
+            } else {
+                fprintf(stderr, "[WARN] 잘못된 to 값 감지: u=%d to=%d\n", u, v);
+                break;
+            }
+            e = e->next;
+        }
+        if (e && guard <= 0) {
+            fprintf(stderr, "[ERR] 간선 출력 중 비정상 루프 의심: u=%d\n", u);
+            return 1;
+        }
+    }
+    printf("\n");
+
+    // 모든 쌍 최단경로 계산
+    DijkstraResult* res = (DijkstraResult*)malloc((size_t)n * sizeof(DijkstraResult));
+    int* path = (int*)malloc((size_t)n * sizeof(int));
+    if (!res || !path) { perror("malloc"); exit(1); }
+    for (int s = 0; s < n; ++s) {
+        initResult(&res[s], n);
+        dijkstra(g, s, &res[s], pq);
+    }
+
+    // 모든 쌍(u<v) 결과 출력
+    printf("모든 노드 쌍(u < v)의 최단경로 결과:\n");
+    for (int u = 0; u < n; ++u) {
+        for (int v = u + 1; v < n; ++v) {
+            int len = reconstructPath(u, v, &res[u], path);
+            if (len == 0) {
+                printf("%2d -> %2d : 거리 = INF, 경로 = (없음)\n", u, v);
+            } else {
+                printf("%2d -> %2d : 거리 = %d, 경로 = ", u, v, res[u].dist[v]);
+                for (int i = 0; i < len; ++i) {
+                    if (i) printf(" -> ");
+                    printf("%d", path[i]);
+                }
+                printf("\n");
+            }
+        }
+    }
+    for (int s = 0; s < n; ++s) freeResult(&res[s]);
+    free(res);
+    free(path);
+    return 0;
+}
+
+/*
+ 사용법
+   hw07                          기본 과제(정점 10, 간선 20) 출력
+   hw07 sssp <n> <m> [maxw] [array]  큰 무작위 그래프(가중치 1~maxw)에서 큐 종류별 단일 출발 Dijkstra 시간
+   hw07 apsp <n> <m> [maxw] [d16|d32|none] [hop] [fw|dijkstra] [pq]
+                                     모든 쌍 최단경로(스레드 수는 OMP_NUM_THREADS).
+                                     기본은 밀도에 따른 비용 모델로 블록 FW / 출발점 병렬 Dijkstra 선택
+   hw07 delta <n> <m> [maxw] [delta] 델타 스테핑 단일 출발 최단경로: 검증과 스레드 수별 가속비
+   hw07 p2p <n> <m> [maxw] [queries] [landmarks]
+                                     점대점 질의: 양방향 Dijkstra / ALT A* 지연 시간(기본 1000질의, 랜드마크 8)
+   hw07 ch <n> <m> [maxw] [queries] [file.ch]
+   hw07 chgrid <rows> <cols> [maxw] [queries] [file.ch]
+                                     축약 계층 전처리/질의(무작위 또는 격자 그래프). file이면 저장 후 다시 읽어 질의
+   hw07 dyn <n> <m> [maxw] [batches] [batch]
+                                     동적 SSSP: 간선 변경 묶음 후 부분 복구 vs 전체 재계산(기본 100묶음 x 10변경)
+   hw07 ms <n> <m> [maxw] [sources] [lanes] [delta]
+                                     다중 출발 묶음: 레인 8/16개 SIMD Dijkstra, 64개 비트마스크 BFS vs 단일 출발(기본 64출발, 16레인)
+   hw07 save <file> [n m [maxw]]     무작위 그래프를 이진 파일로 저장(작으면 결과도 출력)
+   hw07 load <file> [pq]             이진 파일을 읽어 출력(작을 때) 또는 단일 출발 벤치마크
+ pq: array | binary | pairing | dial | radix
+*/
+int main(int argc, char** argv) {
+    seedRng((uint64_t)time(NULL));
+
+    const char* mode = argc > 1 ? argv[1] : "";
+    Graph g;
+    PqKind pq = PQ_BINARY;
+
+    if (strcmp(mode, "load") == 0) {
+        if (argc < 3) {
+            fprintf(stderr, "사용법: %s load <file> [pq]\n", argv[0]);
+            return 1;
+        }
+        if (argc > 3 && !parsePq(argv[3], &pq)) {
+            fprintf(stderr, "[ERR] 알 수 없는 큐 종류: %s\n", argv[3]);
+            return 1;
+        }
+        if (!loadGraphFile(&g, argv[2])) return 1;
+    } else {
+        int n = DEFAULT_N, m = DEFAULT_M, maxW = DEFAULT_MAXW;
+        bool sized = strcmp(mode, "sssp") == 0 || strcmp(mode, "apsp") == 0 || strcmp(mode, "delta") == 0
+                  || strcmp(mode, "p2p") == 0 || strcmp(mode, "ch") == 0 || strcmp(mode, "chgrid") == 0
+                  || strcmp(mode, "dyn") == 0 || strcmp(mode, "ms") == 0;
+        int nArg = sized ? 2 : strcmp(mode, "save") == 0 ? 3 : -1;
+        if (nArg < 0 && argc > 1) {
+            fprintf(stderr, "[ERR] 알 수 없는 모드: %s\n", mode);
+            return 1;
+        }
+        if (nArg > 0 && argc > nArg + 1) {
+            n = atoi(argv[nArg]);
+            m = atoi(argv[nArg + 1]);
+            if (argc > nArg + 2 && isNumber(argv[nArg + 2])) maxW = atoi(argv[nArg + 2]);
+        } else if (sized || (strcmp(mode, "save") == 0 && argc < 3)) {
+            fprintf(stderr, "사용법: %s sssp|apsp|delta|p2p|ch|dyn|ms <n> <m> [maxw] ... | %s save <file> [n m [maxw]]\n", argv[0], argv[0]);
+            return 1;
+        }
+        if (maxW < 1) {
+            fprintf(stderr, "[ERR] 최대 가중치는 1 이상이어야 합니다: %d\n", maxW);
+            return 1;
+        }
+        if (strcmp(mode, "chgrid") == 0) {
+            // n, m 자리가 행, 열
+            if (n < 1 || m < 1 || (long long)n * m > INT_MAX) {
+                fprintf(stderr, "[ERR] 격자 크기 오류: %d x %d\n", n, m);
+                return 1;
+            }
+            initGraph(&g, n * m);
+            generateGridGraph(&g, n, m, maxW);
+        } else {
+            initGraph(&g, n);
+            generateRandomGraph(&g, m, maxW);
+        }
+    }
+
+    // 출력 전 구조 검증
+    if (!validateGraph(&g)) {
+        fprintf(stderr, "[ERR] 그래프 구조가 손상되었습니다.\n");
+        freeGraph(&g);
+        return 1;
+    }
+
+    // hw07 save <file>: 생성한 그래프를 이진 파일로도 저장
+    if (strcmp(mode, "save") == 0) {
+        if (!saveGraphFile(&g, argv[2])) {
+            freeGraph(&g);
+            return 1;
+        }
+        printf("그래프를 %s 에 저장했습니다.\n", argv[2]);
+    }
+
+    int rc = 0;
+    if (strcmp(mode, "ms") == 0) {
+        int S = argc > 5 ? atoi(argv[5]) : 64;
+        int lanes = argc > 6 ? atoi(argv[6]) : MS_MAX_LANES;
+        if (lanes != 8 && lanes != 16) {
+            fprintf(stderr, "[ERR] 레인 수는 8 또는 16이어야 합니다: %d\n", lanes);
+            rc = 1;
+        } else {
+            rc = runMs(&g, S > 0 ? S : 64, lanes, argc > 7 ? atoi(argv[7]) : 0);
+        }
+    } else if (strcmp(mode, "dyn") == 0) {
+        int batches = argc > 5 ? atoi(argv[5]) : 100;
+        int batch = argc > 6 ? atoi(argv[6]) : 10;
+        rc = runDyn(&g, batches > 0 ? batches : 100, batch > 0 ? batch : 10);
+    } else if (strcmp(mode, "ch") == 0 || strcmp(mode, "chgrid") == 0) {
+        int q = argc > 5 ? atoi(argv[5]) : 10000;
+        rc = runCh(&g, q > 0 ? q : 10000, argc > 6 ? argv[6] : NULL);
+    } else if (strcmp(mode, "p2p") == 0) {
+        int q = argc > 5 ? atoi(argv[5]) : 1000;
+        int L = argc > 6 ? atoi(argv[6]) : 8;
+        rc = runP2p(&g, q > 0 ? q : 1000, L > 0 ? L : 8);
+    } else if (strcmp(mode, "delta") == 0) {
+        rc = runDelta(&g, argc > 5 ? atoi(argv[5]) : 0);
+    } else if (strcmp(mode, "apsp") == 0) {
+        rc = runApsp(&g, argc, argv, isNumber(argc > 4 ? argv[4] : "") ? 5 : 4);
+    } else if (strcmp(mode, "sssp") == 0 || g.n > PRINT_LIMIT) {
+        printf("정점 %d, 간선 %d, 최대 가중치 %d, 출발 0\n", g.n, g.m, g.maxW);
+        bool withArray = strcmp(mode, "sssp") == 0 && strcmp(argv[argc - 1], "array") == 0;
+        benchmarkSssp(&g, 0, withArray);
+    } else {
+        rc = printAllPairs(&g, pq);
+    }
+
+    freeGraph(&g);
+    return rc;
+}
@@ -14,6 +14,15 @@
 #include <stdint.h>
 #include <string.h>
 #include <time.h>
+#include <limits.h>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* 빌드 예: gcc -O2 -fopenmp -mavx2 hw08.c -o hw08  (-fopenmp / -mavx2 없이도 단일 스레드·스칼라로 동작) */
 
 /* 설정 */
 #define N            10000
@@ -30,6 +39,53 @@ static inline uint64_t xorshift64(uint64_t *state) {
     return x;
 }
 
+/*
+xorshift64 점프(jump-ahead)
+상태 전이 x -> xorshift64(x)는 GF(2) 위의 64x64 선형 변환 T이므로
+k번 건너뛴 상태는 T^k * x. 행렬은 열 64개(uint64_t)로 두고, T^k는 제곱을 반복해 O(64^2 log k)에 구한다.
+실행 한 번은 난수를 정확히 N개 쓰므로 r번째 실행의 시작 상태 = T^(r*N) * seed.
+*/
+typedef struct { uint64_t col[64]; } Gf2Mat;
+
+/* M * x: x의 켜진 비트 i마다 i번째 열을 XOR */
+static uint64_t gf2_apply(const Gf2Mat *m, uint64_t x) {
+    uint64_t r = 0;
+    for (int i = 0; x; ++i, x >>= 1) {
+        if (x & 1) r ^= m->col[i];
+    }
+    return r;
+}
+
+/* out = a * b (out이 a나 b와 같아도 됨) */
+static void gf2_mul(const Gf2Mat *a, const Gf2Mat *b, Gf2Mat *out) {
+    Gf2Mat t;
+    for (int i = 0; i < 64; ++i) t.col[i] = gf2_apply(a, b->col[i]);
+    *out = t;
+}
+
+/* out = T^k (T: xorshift64 한 단계) */
+static void xorshift64_jump_matrix(uint64_t k, Gf2Mat *out) {
+    Gf2Mat base, r;
+    for (int i = 0; i < 64; ++i) {
+        uint64_t x = (uint64_t)1 << i;
+        base.col[i] = xorshift64(&x);
+        r.col[i] = (uint64_t)1 << i;    /* 단위 행렬 */
+    }
+    while (k) {
+        if (k & 1) gf2_mul(&base, &r, &r);
+        gf2_mul(&base, &base, &base);
+        k >>= 1;
+    }
+    *out = r;
+}
+
+/* 상태를 k단계 앞으로(xorshift64를 k번 부른 것과 같은 결과) */
+static uint64_t xorshift64_jump(uint64_t state, uint64_t k) {
+    Gf2Mat m;
+    xorshift64_jump_matrix(k, &m);
+    return gf2_apply(&m, state);
+}
+
 /* 0 ~ RAND_MAXVAL 범위 난수 생성 */
 static inline int fast_rand_int(uint64_t *state) {
     return (int)(xorshift64(state) % (RAND_MAXVAL + 1));
@@ -40,6 +96,15 @@ static void fill_random(int *a, int n, uint64_t *state) {
     for (int i = 0; i < n; ++i) a[i] = fast_rand_int(state);
 }
 
+/* 경과 시간 측정용(초) */
+static double now_sec(void) {
+#ifdef _OPENMP
+    return omp_get_wtime();
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
 /* 배열 복제 */
 static inline void clone_array(const int *src, int *dst, int n) {
     memcpy(dst, src, sizeof(int) * n);
@@ -110,17 +175,12 @@ static int build_tokuda_gaps(int n, int *gaps, int max_count) {
     return count; /* gaps[0..count-1] 오름차순 */
 }
 
-/* 쉘 정렬(Tokuda 계열 간격 사용) */
-static uint64_t shell_sort_tokuda_count(int *a, int n) {
+/* 쉘 정렬(간격 표 사용): gaps[0..gcount-1] 오름차순, 큰 간격부터 적용 */
+static uint64_t shell_sort_gaps_count(int *a, int n, const int *gaps, int gcount) {
     uint64_t cmp = 0;
-    /* 최대 필요한 gap 개수는 30 내외 (n=10k 기준) */
-    int gaps[64];
-    int gcount = build_tokuda_gaps(n, gaps, 64);
-
-    /* 역순(큰 간격부터) 적용 */
     for (int gi = gcount - 1; gi >= 0; --gi) {
         int gap = gaps[gi];
-        if (gap <= 0) continue;
+        if (gap <= 0 || gap >= n) continue;
         for (int i = gap; i < n; ++i) {
             int temp = a[i];
             int j = i;
@@ -139,56 +199,1426 @@ static uint64_t shell_sort_tokuda_count(int *a, int n) {
     return cmp;
 }
 
-int main(void) {
-    /* 난수 초기화: 시간 기반 + 주소 혼합으로 시드 강화 */
-    uint64_t seed = (uint64_t)time(NULL);
-    seed ^= (uint64_t)(uintptr_t)&seed;
+/* 쉘 정렬(Tokuda 계열 간격 사용) */
+static uint64_t shell_sort_tokuda_count(int *a, int n) {
+    /* 최대 필요한 gap 개수는 30 내외 (n=10k 기준) */
+    int gaps[64];
+    int gcount = build_tokuda_gaps(n, gaps, 64);
+    return shell_sort_gaps_count(a, n, gaps, gcount);
+}
+
+/* 정확한 Tokuda 수열: h(k) = ceil((9 * (9/4)^(k-1) - 4) / 5) (비교용) */
+static int build_tokuda_exact_gaps(int n, int *gaps, int max_count) {
+    int count = 0;
+    double p = 1.0;     /* (9/4)^(k-1) */
+    for (;;) {
+        double v = (9.0 * p - 4.0) / 5.0;
+        int h = (int)v;
+        if (h < v) h++;
+        if (h >= n || count >= max_count) break;
+        gaps[count++] = h;
+        p *= 2.25;
+    }
+    return count;
+}
+
+/* Ciura 수열(1~701은 실험값, 이후는 2.25배 연장) (비교용) */
+static int build_ciura_gaps(int n, int *gaps, int max_count) {
+    static const int ciura[] = { 1, 4, 10, 23, 57, 132, 301, 701 };
+    int count = 0;
+    for (int i = 0; i < (int)(sizeof(ciura) / sizeof(ciura[0])); ++i) {
+        if (ciura[i] >= n || count >= max_count) return count;
+        gaps[count++] = ciura[i];
+    }
+    for (double h = 701.0 * 2.25; (int)h < n && count < max_count; h *= 2.25) gaps[count++] = (int)h;
+    return count;
+}
+
+/*
+N=10000 무작위 배열에 맞춘 간격 표. "hw08 opt 10000"(탐색 표본 100개, seed 1)의 결과를 옮겨 둔 것으로,
+Ciura 수열에서 출발한 국소 탐색이 검증에서 이겼다(아래쪽 301까지는 Ciura와 같고 큰 간격만 다르다).
+검증 표본 400개에서 평균 191016회: 정확한 Tokuda 192620, Ciura 191769보다 적다.
+다른 크기에 쓰려면 같은 명령으로 그 크기용 표를 다시 뽑는다.
+*/
+static const int tuned_gaps[] = { 1, 4, 10, 23, 57, 132, 301, 538, 1401, 3548, 9210 };
+#define TUNED_GAP_COUNT ((int)(sizeof(tuned_gaps) / sizeof(tuned_gaps[0])))
+
+/*
+간격 수열 최적화(경험적)
+- 점수: 같은 표본 배열 묶음(공통 난수)에 대한 평균 비교 횟수. 후보끼리 같은 배열로 비교하므로
+  표본 잡음이 상쇄되어 작은 차이도 가려낼 수 있다. 표본은 스레드에 나눠 병렬로 정렬한다.
+- 1단계(탐욕 연장): 1부터 시작해 다음 간격 후보 c를 이전 간격의 1.7~3.2배 범위에서 고르되,
+  c 위는 2.25배 기하 꼬리로 채운 완성 수열로 점수를 매긴다. "여기서 멈춤"이 더 좋으면 멈춘다.
+- 2단계(국소 탐색): 각 간격을 +-step만큼 움직여 보고 좋아지면 받아들인다. step을 절반씩 줄이며 반복.
+  마지막으로 가장 큰 간격 하나를 빼 보거나 하나 더 붙여 본다. 탐욕 결과뿐 아니라 Ciura, 정확한
+  Tokuda 수열에서도 출발한다(탐욕 연장이 기준 수열보다 나쁜 골짜기에 빠질 수 있으므로).
+- 탐색 표본에 과적합되지 않았는지 새 seed의 검증 표본으로 세 결과와 Tokuda/Ciura/절반 간격을 다시
+  비교하고, 검증 점수가 가장 좋은 수열을 출력한다(기준 수열이 이기면 그대로 알린다).
+*/
+#define OPT_MAX_GAPS   40
+#define OPT_CANDIDATES 24    /* 탐욕 단계에서 간격 하나당 시험할 후보 수 상한 */
+#define OPT_MAX_EVALS  2000  /* 국소 탐색 한 번의 점수 계산 횟수 상한 */
+
+typedef struct {
+    int n;
+    int count;
+    int *data;              /* count개 배열을 이어 붙임 */
+    int threads;
+    long evals;
+} GapOptimizer;
+
+/* 표본 i는 seed에서 i*n단계 건너뛴 상태로 채운다(스레드 수와 무관하게 같은 표본) */
+static int opt_init(GapOptimizer *o, int n, int count, uint64_t seed, int threads) {
+    o->n = n;
+    o->count = count;
+    o->threads = threads;
+    o->evals = 0;
+    o->data = (int*)malloc(sizeof(int) * (size_t)n * count);
+    if (!o->data) return 0;
+    Gf2Mat step;
+    xorshift64_jump_matrix((uint64_t)n, &step);
+    uint64_t state = seed;
+    for (int i = 0; i < count; ++i) {
+        uint64_t s = state;
+        fill_random(o->data + (size_t)i * n, n, &s);
+        state = gf2_apply(&step, state);
+    }
+    return 1;
+}
+
+/* 평균 비교 횟수. 표본별 합은 정수라 스레드 수와 관계없이 같은 값 */
+static double opt_score(GapOptimizer *o, const int *gaps, int gcount) {
+    uint64_t total = 0;
+    int n = o->n, fail = 0;
+    o->evals++;
+    #pragma omp parallel num_threads(o->threads > 0 ? o->threads : 1) reduction(+:total) reduction(|:fail)
+    {
+        int *work = (int*)malloc(sizeof(int) * n);
+        if (!work) fail = 1;
+        #pragma omp for schedule(static)
+        for (int i = 0; i < o->count; ++i) {
+            if (!work) continue;
+            clone_array(o->data + (size_t)i * n, work, n);
+            total += shell_sort_gaps_count(work, n, gaps, gcount);
+        }
+        free(work);
+    }
+    if (fail) {
+        fprintf(stderr, "메모리 할당 실패\n");
+        exit(1);
+    }
+    return (double)total / o->count;
+}
+
+/* gaps[0..count-1] 뒤를 2.25배 기하 꼬리로 n 미만까지 채운 수열의 점수 */
+static double opt_score_with_tail(GapOptimizer *o, const int *gaps, int count) {
+    int tmp[OPT_MAX_GAPS];
+    memcpy(tmp, gaps, sizeof(int) * count);
+    int k = count;
+    double h = tmp[k - 1];
+    for (;;) {
+        h = h * 2.25 + 1.0;
+        if ((int)h >= o->n || k >= OPT_MAX_GAPS) break;
+        tmp[k++] = (int)h;
+    }
+    return opt_score(o, tmp, k);
+}
+
+/* 1단계: 1부터 탐욕 연장. 결과 간격 수를 리턴하고 gaps에 오름차순으로 채운다 */
+static int opt_greedy(GapOptimizer *o, int *gaps) {
+    int n = o->n;
+    int count = 1;
+    gaps[0] = 1;
+    for (;;) {
+        int prev = gaps[count - 1];
+        int lo = (int)(prev * 1.7) + 1, hi = (int)(prev * 3.2) + 1;
+        if (lo <= prev) lo = prev + 1;
+        if (hi >= n) hi = n - 1;
+        if (lo > hi || count >= OPT_MAX_GAPS) break;
+        double stop = opt_score(o, gaps, count);
+        double best = stop;
+        int best_c = 0;
+        int step = (hi - lo) / OPT_CANDIDATES + 1;
+        for (int c = lo; c <= hi; c += step) {
+            gaps[count] = c;
+            double sc = opt_score_with_tail(o, gaps, count + 1);
+            if (sc < best) {
+                best = sc;
+                best_c = c;
+            }
+        }
+        if (!best_c) break;
+        gaps[count++] = best_c;
+        printf("  탐욕 %2d번째 간격 %5d (꼬리 포함 평균 %.0f)\n", count, best_c, best);
+        fflush(stdout);
+    }
+    return count;
+}
+
+/* 2단계: gaps[0..*count-1]에서 출발하는 국소 탐색. 제자리에서 고치고 탐색 표본 점수를 리턴 */
+static double opt_local_search(GapOptimizer *o, int *gaps, int *countp) {
+    int n = o->n, count = *countp;
+    long budget = o->evals + OPT_MAX_EVALS;
+    double cur = opt_score(o, gaps, count);
+    for (int div = 8; div <= 1024 && o->evals < budget; ) {
+        int improved = 0;
+        for (int i = 1; i < count && o->evals < budget; ++i) {
+            int step = gaps[i] / div;
+            if (step < 1) step = 1;
+            for (int dir = -1; dir <= 1; dir += 2) {
+                int old = gaps[i];
+                int v = old + dir * step;
+                if (v <= gaps[i - 1] || (i + 1 < count && v >= gaps[i + 1]) || v >= n) continue;
+                gaps[i] = v;
+                double sc = opt_score(o, gaps, count);
+                if (sc < cur) {
+                    cur = sc;
+                    improved = 1;
+                    break;
+                }
+                gaps[i] = old;
+            }
+        }
+        if (!improved) div *= 2;
+    }
+
+    /* 가장 큰 간격 빼기 / 하나 더 붙이기 */
+    if (count > 1) {
+        double sc = opt_score(o, gaps, count - 1);
+        if (sc < cur) {
+            cur = sc;
+            count--;
+        }
+    }
+    if (count < OPT_MAX_GAPS) {
+        int top = gaps[count - 1];
+        for (int c = (int)(top * 1.7) + 1; c < n && c <= (int)(top * 3.2) + 1; c += (int)(top * 0.1) + 1) {
+            gaps[count] = c;
+            double sc = opt_score(o, gaps, count + 1);
+            if (sc < cur) {
+                cur = sc;
+                count++;
+                break;
+            }
+        }
+    }
+    *countp = count;
+    return cur;
+}
+
+/* hw08 opt [n] [samples] [seed] [threads] */
+static int run_optimizer(int n, int samples, uint64_t seed, int threads) {
+    if (threads <= 0) {
+#ifdef _OPENMP
+        threads = omp_get_max_threads();
+#else
+        threads = 1;
+#endif
+    }
+    GapOptimizer o;
+    if (!opt_init(&o, n, samples, seed, threads)) {
+        fprintf(stderr, "메모리 할당 실패\n");
+        return 1;
+    }
+    printf("간격 최적화: 크기 %d, 탐색 표본 %d, seed %llu, 스레드 %d\n",
+           n, samples, (unsigned long long)seed, threads);
+    double t0 = now_sec();
+
+    /* 국소 탐색 출발점 세 개: 탐욕 연장 결과, Ciura, 정확한 Tokuda */
+    enum { START_GREEDY, START_CIURA, START_TOKUDA, STARTS };
+    static const char *start_names[STARTS] = { "탐욕 연장", "Ciura", "Tokuda(정확)" };
+    int found[STARTS][OPT_MAX_GAPS], fc[STARTS];
+    fc[START_GREEDY] = opt_greedy(&o, found[START_GREEDY]);
+    fc[START_CIURA] = build_ciura_gaps(n, found[START_CIURA], OPT_MAX_GAPS);
+    fc[START_TOKUDA] = build_tokuda_exact_gaps(n, found[START_TOKUDA], OPT_MAX_GAPS);
+    for (int k = 0; k < STARTS; ++k) {
+        double sc = opt_local_search(&o, found[k], &fc[k]);
+        printf("  국소 탐색(%s에서 출발): 탐색 표본 평균 %.0f\n", start_names[k], sc);
+        fflush(stdout);
+    }
+    printf("탐색 완료: 점수 계산 %ld회, %.1f초\n", o.evals, now_sec() - t0);
+    free(o.data);
 
-    /* 버퍼 준비 */
-    int *base = (int*)malloc(sizeof(int) * N);
-    int *a_ins = (int*)malloc(sizeof(int) * N);
-    int *a_shl = (int*)malloc(sizeof(int) * N);
-    int *a_tok = (int*)malloc(sizeof(int) * N);
-    if (!base || !a_ins || !a_shl || !a_tok) {
+    /* 검증: 새 표본(seed를 섞어서)으로 여러 수열 비교 */
+    GapOptimizer v;
+    int vcount = samples * 4;
+    if (!opt_init(&v, n, vcount, seed ^ 0x9E3779B97F4A7C15ULL, threads)) {
         fprintf(stderr, "메모리 할당 실패\n");
         return 1;
     }
+    int halving[OPT_MAX_GAPS], tok[OPT_MAX_GAPS], tok_exact[OPT_MAX_GAPS], ciura[OPT_MAX_GAPS];
+    int hc = 0;
+    for (int g = n / 2; g > 0 && hc < OPT_MAX_GAPS; g /= 2) halving[hc++] = g;
+    for (int i = 0; i < hc / 2; ++i) {
+        int t = halving[i];
+        halving[i] = halving[hc - 1 - i];
+        halving[hc - 1 - i] = t;
+    }
+    int tc = build_tokuda_gaps(n, tok, OPT_MAX_GAPS);
+    int tec = build_tokuda_exact_gaps(n, tok_exact, OPT_MAX_GAPS);
+    int cc = build_ciura_gaps(n, ciura, OPT_MAX_GAPS);
+    double s_half = opt_score(&v, halving, hc);
+    double s_tok = opt_score(&v, tok, tc);
+    double s_tex = opt_score(&v, tok_exact, tec);
+    double s_ciu = opt_score(&v, ciura, cc);
+    double s_found[STARTS];
+    int best_k = 0;
+    for (int k = 0; k < STARTS; ++k) {
+        s_found[k] = opt_score(&v, found[k], fc[k]);
+        if (s_found[k] < s_found[best_k]) best_k = k;
+    }
+    printf("검증 표본 %d개 평균 비교 횟수\n", vcount);
+    printf("  절반 간격          : %.0f\n", s_half);
+    printf("  Tokuda(2.25h+1 근사): %.0f\n", s_tok);
+    printf("  Tokuda(정확)       : %.0f\n", s_tex);
+    printf("  Ciura              : %.0f\n", s_ciu);
+    for (int k = 0; k < STARTS; ++k) {
+        printf("  최적화(%s에서 출발): %.0f (Tokuda 대비 %.2f%%, Ciura 대비 %.2f%%)\n", start_names[k], s_found[k],
+               (1.0 - s_found[k] / s_tex) * 100.0, (1.0 - s_found[k] / s_ciu) * 100.0);
+    }
+
+    /* 검증 점수가 가장 좋은 수열을 출력. 기준 수열이 이기면 최적화 결과 대신 그것을 낸다 */
+    const int *out = found[best_k];
+    int oc = fc[best_k];
+    const char *base_name = NULL;
+    double s_best = s_found[best_k];
+    if (s_ciu <= s_best) { out = ciura; oc = cc; s_best = s_ciu; base_name = "Ciura"; }
+    if (s_tex < s_best) { out = tok_exact; oc = tec; s_best = s_tex; base_name = "Tokuda(정확)"; }
+    if (s_tok < s_best) { out = tok; oc = tc; s_best = s_tok; base_name = "Tokuda(2.25h+1 근사)"; }
+    if (base_name)
+        printf("기준 수열 %s이(가) 검증에서 가장 좋아 최적화 결과 대신 출력한다(최적화 최선보다 %.2f%% 적음)\n",
+               base_name, (1.0 - s_best / s_found[best_k]) * 100.0);
+    else
+        printf("검증 최선: %s에서 출발한 결과\n", start_names[best_k]);
+    printf("static const int tuned_gaps[] = { ");
+    for (int i = 0; i < oc; ++i) printf("%s%d", i ? ", " : "", out[i]);
+    printf(" };\n");
+    free(v.data);
+    return 0;
+}
+
+/*
+LSD 기수 정렬(비교 없음)
+키가 0..RAND_MAXVAL(< 2^20)이므로 10비트 자릿수 두 번이면 끝난다.
+- 한 번 읽으며 두 자릿수의 히스토그램을 같이 세고, 보조 버퍼 하나로 a -> tmp -> a 왕복
+- 흩뿌리기(scatter)는 자릿수 버킷 1024개에 무작위로 쓰므로, RADIX_PREFETCH개 앞 원소가
+  쓰일 자리를 미리 prefetch 해 둔다
+*/
+#define RADIX_BITS     10
+#define RADIX_SIZE     (1 << RADIX_BITS)
+#define RADIX_MASK     (RADIX_SIZE - 1)
+#define RADIX_PREFETCH 16
+
+#if RAND_MAXVAL >= (1 << (2 * RADIX_BITS))
+#error "RAND_MAXVAL이 기수 정렬 두 자릿수 범위를 넘음"
+#endif
+
+/* src의 shift 자릿수를 기준으로 dst에 안정적으로 흩뿌린다. pos는 버킷별 다음 쓰기 위치(갱신됨) */
+static void radix_scatter(const int *src, int *dst, int lo, int hi, int shift, uint32_t *pos) {
+    for (int i = lo; i < hi; ++i) {
+        if (i + RADIX_PREFETCH < hi) {
+            __builtin_prefetch(&dst[pos[((unsigned)src[i + RADIX_PREFETCH] >> shift) & RADIX_MASK]], 1);
+        }
+        unsigned d = ((unsigned)src[i] >> shift) & RADIX_MASK;
+        dst[pos[d]++] = src[i];
+    }
+}
+
+static void radix_sort_lsd(int *a, int *tmp, int n) {
+    uint32_t pos0[RADIX_SIZE] = { 0 }, pos1[RADIX_SIZE] = { 0 };
+    for (int i = 0; i < n; ++i) {
+        unsigned k = (unsigned)a[i];
+        pos0[k & RADIX_MASK]++;
+        pos1[(k >> RADIX_BITS) & RADIX_MASK]++;
+    }
+    uint32_t s0 = 0, s1 = 0;
+    for (int d = 0; d < RADIX_SIZE; ++d) {
+        uint32_t c0 = pos0[d], c1 = pos1[d];
+        pos0[d] = s0;
+        pos1[d] = s1;
+        s0 += c0;
+        s1 += c1;
+    }
+    radix_scatter(a, tmp, 0, n, 0, pos0);
+    radix_scatter(tmp, a, 0, n, RADIX_BITS, pos1);
+}
+
+/*
+병렬 LSD 기수 정렬: 스레드마다 연속 구간 하나와 자기 히스토그램을 갖는다.
+쓰기 위치는 (자릿수, 스레드) 순서의 누적합이라 각 스레드가 겹치지 않는 자리에 쓰고 정렬은 안정적이다.
+*/
+static int radix_sort_lsd_parallel(int *a, int *tmp, int n, int threads) {
+    if (threads < 1) threads = 1;
+    uint32_t *hist = (uint32_t*)malloc(sizeof(uint32_t) * RADIX_SIZE * (size_t)threads);
+    if (!hist) return 0;
+
+    #pragma omp parallel num_threads(threads)
+    {
+        int tid = 0, nth = 1;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+        nth = omp_get_num_threads();
+#endif
+        int lo = (int)((long long)n * tid / nth);
+        int hi = (int)((long long)n * (tid + 1) / nth);
+        uint32_t *mine = hist + (size_t)tid * RADIX_SIZE;
+        for (int pass = 0; pass < 2; ++pass) {
+            const int *src = pass ? tmp : a;
+            int *dst = pass ? a : tmp;
+            int shift = pass * RADIX_BITS;
+            memset(mine, 0, sizeof(uint32_t) * RADIX_SIZE);
+            for (int i = lo; i < hi; ++i) mine[((unsigned)src[i] >> shift) & RADIX_MASK]++;
+            #pragma omp barrier
+            #pragma omp single
+            {
+                uint32_t s = 0;
+                for (int d = 0; d < RADIX_SIZE; ++d) {
+                    for (int t = 0; t < nth; ++t) {
+                        uint32_t c = hist[(size_t)t * RADIX_SIZE + d];
+                        hist[(size_t)t * RADIX_SIZE + d] = s;
+                        s += c;
+                    }
+                }
+            }
+            radix_scatter(src, dst, lo, hi, shift, mine);
+            #pragma omp barrier
+        }
+    }
+    free(hist);
+    return 1;
+}
+
+static int cmp_int(const void *x, const void *y) {
+    int a = *(const int*)x, b = *(const int*)y;
+    return (a > b) - (a < b);
+}
+
+/* 벤치/퍼저 공용 버퍼 묶음: 원본, 기준 결과(qsort 등), 정렬 대상, 보조(기수/병합용) 각 n개 */
+typedef struct {
+    int *base, *ref, *work, *tmp;
+} SortBufs;
+
+static void sort_bufs_free(SortBufs *b) {
+    free(b->base); free(b->ref); free(b->work); free(b->tmp);
+}
+
+/* 실패하면 메시지를 찍고 이미 잡은 것은 풀고 0 */
+static int sort_bufs_alloc(SortBufs *b, int n) {
+    size_t bytes = sizeof(int) * (size_t)(n > 0 ? n : 1);
+    b->base = (int*)malloc(bytes);
+    b->ref = (int*)malloc(bytes);
+    b->work = (int*)malloc(bytes);
+    b->tmp = (int*)malloc(bytes);
+    if (!b->base || !b->ref || !b->work || !b->tmp) {
+        fprintf(stderr, "메모리 할당 실패\n");
+        sort_bufs_free(b);
+        return 0;
+    }
+    return 1;
+}
+
+/* hw08 radix [n] [reps] [threads]: 큰 배열에서 qsort / 쉘 정렬 / 기수 정렬(직렬, 병렬) 시간 비교 */
+static int run_radix_bench(int n, int reps, int threads) {
+    if (threads <= 0) {
+#ifdef _OPENMP
+        threads = omp_get_max_threads();
+#else
+        threads = 1;
+#endif
+    }
+    SortBufs b;
+    if (!sort_bufs_alloc(&b, n)) return 1;
+    int *base = b.base, *ref = b.ref, *work = b.work, *tmp = b.tmp;
+    int gaps[64];
+    int gcount = build_tokuda_exact_gaps(n, gaps, 64);
+    double sec[4] = { 0 };
+    int bad = 0;
+    uint64_t state = 88172645463325252ULL;
+    for (int r = 0; r < reps && !bad; ++r) {
+        fill_random(base, n, &state);
+        double t0;
+
+        clone_array(base, ref, n);
+        t0 = now_sec();
+        qsort(ref, (size_t)n, sizeof(int), cmp_int);
+        sec[0] += now_sec() - t0;
+
+        clone_array(base, work, n);
+        t0 = now_sec();
+        shell_sort_gaps_count(work, n, gaps, gcount);
+        sec[1] += now_sec() - t0;
+        if (memcmp(work, ref, sizeof(int) * (size_t)n) != 0) bad = 1;
+
+        clone_array(base, work, n);
+        t0 = now_sec();
+        radix_sort_lsd(work, tmp, n);
+        sec[2] += now_sec() - t0;
+        if (memcmp(work, ref, sizeof(int) * (size_t)n) != 0) bad = 1;
+
+        clone_array(base, work, n);
+        t0 = now_sec();
+        if (!radix_sort_lsd_parallel(work, tmp, n, threads)) bad = 1;
+        sec[3] += now_sec() - t0;
+        if (memcmp(work, ref, sizeof(int) * (size_t)n) != 0) bad = 1;
+    }
+    printf("데이터 크기: %d, 반복: %d, 스레드: %d\n", n, reps, threads);
+    printf("  qsort                 : %9.3f ms\n", sec[0] / reps * 1e3);
+    printf("  쉘 정렬(Tokuda)       : %9.3f ms\n", sec[1] / reps * 1e3);
+    printf("  LSD 기수 정렬         : %9.3f ms (qsort 대비 x%.1f, 쉘 정렬 대비 x%.1f)\n", sec[2] / reps * 1e3,
+           sec[2] > 0 ? sec[0] / sec[2] : 0.0, sec[2] > 0 ? sec[1] / sec[2] : 0.0);
+    printf("  LSD 기수 정렬(병렬)   : %9.3f ms (직렬 대비 x%.2f)\n", sec[3] / reps * 1e3,
+           sec[3] > 0 ? sec[2] / sec[3] : 0.0);
+    if (bad) fprintf(stderr, "[ERR] 정렬 결과가 qsort와 다릅니다\n");
+    else printf("  검증: 모든 결과가 qsort와 일치\n");
+    sort_bufs_free(&b);
+    return bad;
+}
+
+/*
+AVX2 정렬(int 배열)
+- 64개 이하 블록: INT_MAX로 8의 2제곱 배 벡터 수만큼 채워 레지스터에 올리고,
+  벡터 하나(8개)는 비토닉 정렬망(치환 + min/max + blend 6단계)으로, 벡터끼리는 비토닉 병합으로 합친다.
+- 큰 구간: 벡터 분할(피벗과 비교한 마스크로 LUT 치환 -> 왼쪽/오른쪽 끝에 동시에 저장)하는 퀵정렬.
+  재귀 깊이가 2*log2(n)을 넘으면 쉘 정렬로 넘겨 최악 O(n^2)를 피한다.
+- -mavx2 없이 빌드하면 같은 구조의 스칼라 분할 + 삽입 정렬로 동작한다.
+*/
+#define VSORT_SMALL 64
+
+#ifdef __AVX2__
+/* 레인 i를 짝 perm[i]와 비교해 mask의 비트가 켜진 레인에는 max, 나머지에는 min */
+#define VS_CMPX(v, perm, mask) \
+    _mm256_blend_epi32(_mm256_min_epi32((v), _mm256_permutevar8x32_epi32((v), (perm))), \
+                       _mm256_max_epi32((v), _mm256_permutevar8x32_epi32((v), (perm))), (mask))
+
+static inline __m256i vs_reverse(__m256i v) {
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+/* 벡터 하나의 비토닉 수열을 오름차순으로(거리 4, 2, 1) */
+static inline __m256i vs_merge8(__m256i v) {
+    v = VS_CMPX(v, _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3), 0xF0);
+    v = VS_CMPX(v, _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5), 0xCC);
+    v = VS_CMPX(v, _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6), 0xAA);
+    return v;
+}
+
+/* 벡터 하나 정렬: 8원소 비토닉 정렬망 */
+static inline __m256i vs_sort8(__m256i v) {
+    const __m256i p1 = _mm256_setr_epi32(1, 0, 3, 2, 5, 4, 7, 6);
+    const __m256i p2 = _mm256_setr_epi32(2, 3, 0, 1, 6, 7, 4, 5);
+    v = VS_CMPX(v, p1, 0x66);
+    v = VS_CMPX(v, p2, 0x3C);
+    v = VS_CMPX(v, p1, 0x5A);
+    return vs_merge8(v);
+}
+
+/* v[0..k)와 v[k..2k)가 각각 오름차순일 때 v[0..2k) 전체를 오름차순으로(k는 2의 거듭제곱) */
+static void vs_merge_regs(__m256i *v, int k) {
+    /* 뒤쪽을 뒤집어 비토닉 수열로 만든 뒤 바로 첫 단계(거리 k 벡터) 비교 */
+    for (int i = 0; i < k; ++i) {
+        __m256i b = vs_reverse(v[2 * k - 1 - i]);
+        __m256i lo = _mm256_min_epi32(v[i], b), hi = _mm256_max_epi32(v[i], b);
+        v[i] = lo;
+        v[2 * k - 1 - i] = hi;
+    }
+    /* 뒤쪽 절반은 위에서 역순으로 저장했으므로 다시 뒤집는다 */
+    for (int i = 0; i < k / 2; ++i) {
+        __m256i t = v[k + i];
+        v[k + i] = v[2 * k - 1 - i];
+        v[2 * k - 1 - i] = t;
+    }
+    for (int i = k; i < 2 * k; ++i) v[i] = vs_reverse(v[i]);
+    /* 이제 두 절반 각각이 비토닉: 벡터 거리 d = k/2, k/4, ..., 1 비교 후 벡터 안 정리 */
+    for (int d = k / 2; d >= 1; d /= 2) {
+        for (int i = 0; i < 2 * k; ++i) {
+            if (i & d) continue;
+            __m256i lo = _mm256_min_epi32(v[i], v[i + d]), hi = _mm256_max_epi32(v[i], v[i + d]);
+            v[i] = lo;
+            v[i + d] = hi;
+        }
+    }
+    for (int i = 0; i < 2 * k; ++i) v[i] = vs_merge8(v[i]);
+}
+
+/* n <= 64개 정렬: 레지스터 정렬망 + 비토닉 병합 */
+static void vs_sort_small(int *a, int n) {
+    if (n <= 1) return;
+    int buf[VSORT_SMALL];
+    int k = 1;
+    while (k * 8 < n) k *= 2;
+    memcpy(buf, a, sizeof(int) * n);
+    for (int i = n; i < k * 8; ++i) buf[i] = INT_MAX;
+    __m256i v[VSORT_SMALL / 8];
+    for (int i = 0; i < k; ++i) v[i] = vs_sort8(_mm256_loadu_si256((const __m256i*)(buf + 8 * i)));
+    for (int w = 1; w < k; w *= 2) {
+        for (int i = 0; i < k; i += 2 * w) vs_merge_regs(v + i, w);
+    }
+    for (int i = 0; i < k; ++i) _mm256_storeu_si256((__m256i*)(buf + 8 * i), v[i]);
+    memcpy(a, buf, sizeof(int) * n);
+}
+
+/* 압축 치환표: 마스크 m(비트 = 오른쪽으로 갈 레인)에 대해 왼쪽으로 갈 레인을 앞에, 나머지를 뒤에 모은다 */
+static int vs_lut_ready;
+static __m256i vs_lut[256];
+
+/* 처음 한 번만 만든다(병렬 구간 밖에서 vsort_int를 처음 부른다고 가정) */
+static void vs_init_lut(void) {
+    if (vs_lut_ready) return;
+    for (int m = 0; m < 256; ++m) {
+        int idx[8], c = 0;
+        for (int i = 0; i < 8; ++i) if (!(m & (1 << i))) idx[c++] = i;
+        for (int i = 0; i < 8; ++i) if (m & (1 << i)) idx[c++] = i;
+        vs_lut[m] = _mm256_loadu_si256((const __m256i*)idx);
+    }
+    vs_lut_ready = 1;
+}
+
+/* 벡터 하나를 분할해 왼쪽 끝(*left)과 오른쪽 끝(*right)에 함께 저장하고 두 끝을 옮긴다 */
+static inline void vs_store_part(int *a, __m256i v, __m256i pv, int strict, int *left, int *right) {
+    /* strict == 0: x > pivot이 오른쪽, strict == 1: x >= pivot이 오른쪽 */
+    __m256i gt = strict ? _mm256_xor_si256(_mm256_cmpgt_epi32(pv, v), _mm256_set1_epi32(-1))
+                        : _mm256_cmpgt_epi32(v, pv);
+    int m = _mm256_movemask_ps(_mm256_castsi256_ps(gt));
+    int cnt = __builtin_popcount((unsigned)m);
+    __m256i p = _mm256_permutevar8x32_epi32(v, vs_lut[m]);
+    _mm256_storeu_si256((__m256i*)(a + *left), p);
+    _mm256_storeu_si256((__m256i*)(a + *right - 8), p);
+    *left += 8 - cnt;
+    *right -= cnt;
+}
+
+/*
+제자리 벡터 분할. [0, n) (n >= 16)을 [0, 리턴값) <= pivot(strict면 < pivot), 나머지로 나눈다.
+양 끝 벡터를 먼저 빼 두면 빈 자리가 왼쪽 8 + 오른쪽 8이 되고, 빈 자리가 적은 쪽에서 읽으면
+양 끝에 8개씩 통째로 써도 아직 읽지 않은 원소를 덮지 않는다.
+*/
+static int vs_partition(int *a, int n, int pivot, int strict) {
+    __m256i pv = _mm256_set1_epi32(pivot);
+    __m256i first = _mm256_loadu_si256((const __m256i*)a);
+    __m256i last = _mm256_loadu_si256((const __m256i*)(a + n - 8));
+    int left = 0, right = n;
+    int readL = 8, readR = n - 8;
+    while (readR - readL >= 8) {
+        __m256i v;
+        if (readL - left <= right - readR) {
+            v = _mm256_loadu_si256((const __m256i*)(a + readL));
+            readL += 8;
+        } else {
+            readR -= 8;
+            v = _mm256_loadu_si256((const __m256i*)(a + readR));
+        }
+        vs_store_part(a, v, pv, strict, &left, &right);
+    }
+    /* 남은 8개 미만은 복사해 두고 하나씩(이제 [left, right)가 모두 빈 자리) */
+    int rest[8], rc = readR - readL;
+    memcpy(rest, a + readL, sizeof(int) * rc);
+    for (int i = 0; i < rc; ++i) {
+        int x = rest[i];
+        if (strict ? x < pivot : x <= pivot) a[left++] = x;
+        else a[--right] = x;
+    }
+    vs_store_part(a, first, pv, strict, &left, &right);
+    vs_store_part(a, last, pv, strict, &left, &right);
+    return left;
+}
+#else
+/* 스칼라 대체 경로 */
+static void vs_sort_small(int *a, int n) {
+    for (int i = 1; i < n; ++i) {
+        int key = a[i], j = i;
+        while (j > 0 && a[j - 1] > key) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = key;
+    }
+}
+
+static void vs_init_lut(void) {}
+
+static int vs_partition(int *a, int n, int pivot, int strict) {
+    int i = 0, j = n;
+    for (;;) {
+        while (i < j && (strict ? a[i] < pivot : a[i] <= pivot)) i++;
+        while (i < j && !(strict ? a[j - 1] < pivot : a[j - 1] <= pivot)) j--;
+        if (i >= j) return i;
+        int t = a[i];
+        a[i] = a[j - 1];
+        a[j - 1] = t;
+    }
+}
+#endif
+
+static inline int median3(int x, int y, int z) {
+    if (x > y) { int t = x; x = y; y = t; }
+    if (y > z) y = z;
+    return x > y ? x : y;
+}
+
+static void vs_quicksort(int *a, int n, int depth) {
+    while (n > VSORT_SMALL) {
+        if (depth-- <= 0) {
+            int gaps[64];
+            shell_sort_gaps_count(a, n, gaps, build_tokuda_exact_gaps(n, gaps, 64));
+            return;
+        }
+        int pivot = median3(median3(a[0], a[n / 8], a[n / 4]),
+                            median3(a[n / 2 - n / 8], a[n / 2], a[n / 2 + n / 8]),
+                            median3(a[n - 1 - n / 4], a[n - 1 - n / 8], a[n - 1]));
+        int mid = vs_partition(a, n, pivot, 0);
+        if (mid == n) {
+            /* 모두 <= pivot: 피벗과 같은 값을 오른쪽으로 떼어 낸다(그쪽은 이미 정렬됨) */
+            mid = vs_partition(a, n, pivot, 1);
+            n = mid;
+            continue;
+        }
+        /* 작은 쪽을 재귀, 큰 쪽은 반복(스택 깊이 O(log n)) */
+        if (mid < n - mid) {
+            vs_quicksort(a, mid, depth);
+            a += mid;
+            n -= mid;
+        } else {
+            vs_quicksort(a + mid, n - mid, depth);
+            n = mid;
+        }
+    }
+    vs_sort_small(a, n);
+}
+
+static void vsort_int(int *a, int n) {
+    vs_init_lut();
+    int depth = 0;
+    for (int m = n; m > 1; m >>= 1) depth += 2;
+    vs_quicksort(a, n, depth);
+}
+
+/* 정렬 검증용 퍼저: 크기 경계값/무작위 크기와 여러 분포에서 vsort_int를 쉘 정렬, 기수 정렬과 대조 */
+static int run_vsort_fuzz(int iters, uint64_t seed) {
+    static const int edge[] = { 0, 1, 2, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 1000 };
+    int nedge = (int)(sizeof(edge) / sizeof(edge[0]));
+    int maxn = 1 << 14;
+    SortBufs b;
+    if (!sort_bufs_alloc(&b, maxn)) return 1;
+    int *base = b.base, *ref = b.ref, *work = b.work, *tmp = b.tmp;
+    uint64_t st = seed ? seed : 88172645463325252ULL;
+    int gaps[64];
+    int fails = 0;
+    for (int it = 0; it < iters && fails < 5; ++it) {
+        int n = it < nedge ? edge[it] : (int)(xorshift64(&st) % (uint64_t)(it % 4 ? 300 : maxn));
+        int dist = (int)(xorshift64(&st) % 6);
+        int bounded = dist <= 3;    /* 0..RAND_MAXVAL 범위면 기수 정렬로도 대조 */
+        for (int i = 0; i < n; ++i) {
+            uint64_t r = xorshift64(&st);
+            switch (dist) {
+            case 0: base[i] = (int)(r % (RAND_MAXVAL + 1)); break;            /* 과제 분포 */
+            case 1: base[i] = (int)(r % 4); break;                            /* 중복 많음 */
+            case 2: base[i] = i; break;                                       /* 정렬됨 */
+            case 3: base[i] = n - i; break;                                   /* 역순 */
+            case 4: base[i] = (int)(uint32_t)r; break;                        /* 음수 포함 전 범위 */
+            default: base[i] = (r & 1) ? INT_MAX : INT_MIN; break;            /* 극값 */
+            }
+        }
+        clone_array(base, ref, n);
+        shell_sort_gaps_count(ref, n, gaps, build_tokuda_exact_gaps(n, gaps, 64));
+        clone_array(base, work, n);
+        vsort_int(work, n);
+        int bad = memcmp(work, ref, sizeof(int) * (size_t)n) != 0;
+        if (!bad && bounded) {
+            clone_array(base, work, n);
+            radix_sort_lsd(work, tmp, n);
+            bad = memcmp(work, ref, sizeof(int) * (size_t)n) != 0;
+        }
+        if (bad) {
+            fprintf(stderr, "[ERR] 반복 %d: 크기 %d, 분포 %d에서 결과 불일치\n", it, n, dist);
+            fails++;
+        }
+    }
+    if (!fails) printf("퍼저: %d회 모두 일치 (AVX2 %s)\n", iters,
+#ifdef __AVX2__
+                       "사용"
+#else
+                       "미사용"
+#endif
+    );
+    sort_bufs_free(&b);
+    return fails != 0;
+}
+
+/* hw08 vsort [n] [reps]: qsort / AVX2 정렬 / 기수 정렬 처리량(원소/초) */
+static int run_vsort_bench(int n, int reps) {
+    SortBufs b;
+    if (!sort_bufs_alloc(&b, n)) return 1;
+    int *base = b.base, *ref = b.ref, *work = b.work, *tmp = b.tmp;
+    double sec[3] = { 0 };
+    int bad = 0;
+    uint64_t st = 88172645463325252ULL;
+    for (int r = 0; r < reps; ++r) {
+        fill_random(base, n, &st);
+        double t0;
+        clone_array(base, ref, n);
+        t0 = now_sec();
+        qsort(ref, (size_t)n, sizeof(int), cmp_int);
+        sec[0] += now_sec() - t0;
+        clone_array(base, work, n);
+        t0 = now_sec();
+        vsort_int(work, n);
+        sec[1] += now_sec() - t0;
+        bad |= memcmp(work, ref, sizeof(int) * (size_t)n) != 0;
+        clone_array(base, work, n);
+        t0 = now_sec();
+        radix_sort_lsd(work, tmp, n);
+        sec[2] += now_sec() - t0;
+        bad |= memcmp(work, ref, sizeof(int) * (size_t)n) != 0;
+    }
+    double elems = (double)n * reps;
+    printf("데이터 크기: %d, 반복: %d\n", n, reps);
+    printf("  qsort          : %8.1f M원소/초\n", sec[0] > 0 ? elems / sec[0] / 1e6 : 0.0);
+    printf("  AVX2 정렬      : %8.1f M원소/초 (qsort 대비 x%.1f)\n", sec[1] > 0 ? elems / sec[1] / 1e6 : 0.0,
+           sec[1] > 0 ? sec[0] / sec[1] : 0.0);
+    printf("  LSD 기수 정렬  : %8.1f M원소/초 (qsort 대비 x%.1f)\n", sec[2] > 0 ? elems / sec[2] / 1e6 : 0.0,
+           sec[2] > 0 ? sec[0] / sec[2] : 0.0);
+    if (bad) fprintf(stderr, "[ERR] 정렬 결과가 qsort와 다릅니다\n");
+    else printf("  검증: 모든 결과가 qsort와 일치\n");
+    sort_bufs_free(&b);
+    return bad;
+}
+
+/*
+입력 분포(실제 데이터는 균등 난수가 아니라 부분적으로 정렬된 경우가 많다)
+*/
+enum {
+    DIST_UNIFORM,           /* 균등 난수(과제 기본, fill_random과 같음) */
+    DIST_SORTED,            /* 이미 정렬됨 */
+    DIST_NEARLY_SORTED,     /* 정렬 후 1%의 자리만 무작위 교환 */
+    DIST_REVERSED,          /* 역순 */
+    DIST_SAWTOOTH,          /* 오름차순 구간 16개가 이어짐 */
+    DIST_FEW_UNIQUE,        /* 서로 다른 값 16개 */
+    DIST_COUNT
+};
+
+static const char *const dist_names[DIST_COUNT] = {
+    "균등 난수", "정렬됨", "거의 정렬됨(1% 교환)", "역순", "톱니(오름차순 구간 16개)", "값 16종",
+};
+
+static void fill_dist(int *a, int n, int dist, uint64_t *state) {
+    switch (dist) {
+    case DIST_SORTED:
+    case DIST_NEARLY_SORTED:
+    case DIST_REVERSED:
+        for (int i = 0; i < n; ++i) a[i] = (int)((long long)i * RAND_MAXVAL / (n > 1 ? n - 1 : 1));
+        if (dist == DIST_REVERSED) {
+            for (int i = 0; i < n / 2; ++i) {
+                int t = a[i];
+                a[i] = a[n - 1 - i];
+                a[n - 1 - i] = t;
+            }
+        } else if (dist == DIST_NEARLY_SORTED) {
+            for (int k = 0; k < n / 100; ++k) {
+                int i = (int)(xorshift64(state) % (uint64_t)n), j = (int)(xorshift64(state) % (uint64_t)n);
+                int t = a[i];
+                a[i] = a[j];
+                a[j] = t;
+            }
+        }
+        break;
+    case DIST_SAWTOOTH: {
+        int run = n / 16 > 0 ? n / 16 : 1;
+        for (int i = 0; i < n; ++i) a[i] = (int)((long long)(i % run) * RAND_MAXVAL / run);
+        break;
+    }
+    case DIST_FEW_UNIQUE:
+        for (int i = 0; i < n; ++i) a[i] = (int)(xorshift64(state) % 16) * (RAND_MAXVAL / 16);
+        break;
+    default:
+        fill_random(a, n, state);
+        break;
+    }
+}
+
+/* 비교 하나마다 카운트하는 "x < y" */
+#define LESS(x, y) (++*cmp, (x) < (y))
+
+static inline void swap_int(int *a, int i, int j) {
+    int t = a[i];
+    a[i] = a[j];
+    a[j] = t;
+}
+
+/*
+pdqsort(pattern-defeating quicksort, Orson Peters)
+- 작은 구간은 삽입 정렬, 피벗은 3개 중앙값(128개 초과면 9개의 중앙값)
+- 앞 구간의 마지막 원소(왼쪽 이웃)가 피벗과 같으면 같은 값들을 한 번에 왼쪽으로 모아 건너뜀(중복 많은 입력)
+- 분할 중 교환이 한 번도 없었으면 양쪽을 "이동 8회까지만" 삽입 정렬로 시도해 끝나면 종료(정렬/거의 정렬 입력)
+- 분할이 심하게 치우치면 원소 몇 개를 섞어 패턴을 깨고, log2(n)번 넘게 치우치면 힙 정렬로 넘어감
+*/
+#define PDQ_INSERTION   24
+#define PDQ_NINTHER     128
+#define PDQ_PARTIAL_MAX 8
+
+static void insertion_sort_cmp(int *a, int n, uint64_t *cmp) {
+    for (int i = 1; i < n; ++i) {
+        int key = a[i];
+        int j = i;
+        while (j > 0 && LESS(key, a[j - 1])) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = key;
+    }
+}
+
+/* 이동이 PDQ_PARTIAL_MAX를 넘으면 중단하고 0, 끝까지 정렬했으면 1 */
+static int partial_insertion_sort(int *a, int n, uint64_t *cmp) {
+    int moved = 0;
+    for (int i = 1; i < n; ++i) {
+        if (moved > PDQ_PARTIAL_MAX) return 0;
+        int key = a[i];
+        int j = i;
+        if (LESS(key, a[j - 1])) {
+            do {
+                a[j] = a[j - 1];
+                j--;
+            } while (j > 0 && LESS(key, a[j - 1]));
+            a[j] = key;
+            moved += i - j;
+        }
+    }
+    return 1;
+}
+
+static void heap_sift(int *a, int i, int n, uint64_t *cmp) {
+    int x = a[i];
+    for (;;) {
+        int c = 2 * i + 1;
+        if (c >= n) break;
+        if (c + 1 < n && LESS(a[c], a[c + 1])) c++;
+        if (!LESS(x, a[c])) break;
+        a[i] = a[c];
+        i = c;
+    }
+    a[i] = x;
+}
+
+static void heap_sort_cmp(int *a, int n, uint64_t *cmp) {
+    for (int i = n / 2 - 1; i >= 0; --i) heap_sift(a, i, n, cmp);
+    for (int e = n - 1; e > 0; --e) {
+        swap_int(a, 0, e);
+        heap_sift(a, 0, e, cmp);
+    }
+}
+
+/* a[i] <= a[j] <= a[k]가 되도록 정렬 */
+static void sort3_cmp(int *a, int i, int j, int k, uint64_t *cmp) {
+    if (LESS(a[j], a[i])) swap_int(a, i, j);
+    if (LESS(a[k], a[j])) swap_int(a, j, k);
+    if (LESS(a[j], a[i])) swap_int(a, i, j);
+}
+
+/* 피벗 a[0] 기준: [0, p) < pivot, a[p] = pivot, (p, n) >= pivot. 교환이 없었으면 *already = 1 */
+static int pdq_partition_right(int *a, int n, int *already, uint64_t *cmp) {
+    int pivot = a[0];
+    int first = 0, last = n;
+    while (LESS(a[++first], pivot)) {}
+    if (first == 1) {
+        while (first < last && !LESS(a[--last], pivot)) {}
+    } else {
+        while (!LESS(a[--last], pivot)) {}
+    }
+    *already = first >= last;
+    while (first < last) {
+        swap_int(a, first, last);
+        while (LESS(a[++first], pivot)) {}
+        while (!LESS(a[--last], pivot)) {}
+    }
+    int p = first - 1;
+    a[0] = a[p];
+    a[p] = pivot;
+    return p;
+}
+
+/* 피벗과 같은 원소를 왼쪽으로: [0, p] <= pivot, (p, n) > pivot */
+static int pdq_partition_left(int *a, int n, uint64_t *cmp) {
+    int pivot = a[0];
+    int first = 0, last = n;
+    while (LESS(pivot, a[--last])) {}
+    if (last + 1 == n) {
+        while (first < last && !LESS(pivot, a[++first])) {}
+    } else {
+        while (!LESS(pivot, a[++first])) {}
+    }
+    while (first < last) {
+        swap_int(a, first, last);
+        while (LESS(pivot, a[--last])) {}
+        while (!LESS(pivot, a[++first])) {}
+    }
+    a[0] = a[last];
+    a[last] = pivot;
+    return last;
+}
+
+static void pdq_loop(int *a, int n, int bad_allowed, int leftmost, uint64_t *cmp) {
+    for (;;) {
+        if (n < PDQ_INSERTION) {
+            insertion_sort_cmp(a, n, cmp);
+            return;
+        }
+        int s2 = n / 2;
+        if (n > PDQ_NINTHER) {
+            sort3_cmp(a, 0, s2, n - 1, cmp);
+            sort3_cmp(a, 1, s2 - 1, n - 2, cmp);
+            sort3_cmp(a, 2, s2 + 1, n - 3, cmp);
+            sort3_cmp(a, s2 - 1, s2, s2 + 1, cmp);
+            swap_int(a, 0, s2);
+        } else {
+            sort3_cmp(a, s2, 0, n - 1, cmp);
+        }
+
+        /* 왼쪽 이웃(이미 자리 잡은 앞 구간 최댓값)과 피벗이 같으면 같은 값 덩어리를 떼어 낸다 */
+        if (!leftmost && !LESS(a[-1], a[0])) {
+            int p = pdq_partition_left(a, n, cmp);
+            a += p + 1;
+            n -= p + 1;
+            continue;
+        }
+
+        int already = 0;
+        int p = pdq_partition_right(a, n, &already, cmp);
+        int l = p, r = n - p - 1;
+        if (l < n / 8 || r < n / 8) {
+            if (--bad_allowed == 0) {
+                heap_sort_cmp(a, n, cmp);
+                return;
+            }
+            if (l >= PDQ_INSERTION) {
+                swap_int(a, 0, l / 4);
+                swap_int(a, p - 1, p - l / 4);
+                if (l > PDQ_NINTHER) {
+                    swap_int(a, 1, l / 4 + 1);
+                    swap_int(a, 2, l / 4 + 2);
+                    swap_int(a, p - 2, p - (l / 4 + 1));
+                    swap_int(a, p - 3, p - (l / 4 + 2));
+                }
+            }
+            if (r >= PDQ_INSERTION) {
+                swap_int(a, p + 1, p + 1 + r / 4);
+                swap_int(a, n - 1, n - r / 4);
+                if (r > PDQ_NINTHER) {
+                    swap_int(a, p + 2, p + 2 + r / 4);
+                    swap_int(a, p + 3, p + 3 + r / 4);
+                    swap_int(a, n - 2, n - (1 + r / 4));
+                    swap_int(a, n - 3, n - (2 + r / 4));
+                }
+            }
+        } else if (already && partial_insertion_sort(a, l, cmp) && partial_insertion_sort(a + p + 1, r, cmp)) {
+            return;
+        }
+        pdq_loop(a, l, bad_allowed, leftmost, cmp);
+        a += p + 1;
+        n = r;
+        leftmost = 0;
+    }
+}
+
+static uint64_t pdqsort_count(int *a, int n) {
+    uint64_t cmp = 0;
+    int bad_allowed = 1;
+    for (int m = n; m > 1; m >>= 1) bad_allowed++;
+    if (n > 1) pdq_loop(a, n, bad_allowed, 1, &cmp);
+    return cmp;
+}
+
+/*
+timsort 계열 자연 병합 정렬
+- 앞에서부터 오름차순(또는 엄격한 내림차순을 뒤집은) 자연 구간을 찾고, minrun(32~64)보다 짧으면
+  이진 삽입 정렬로 늘린다
+- 구간 스택 불변식 |Z| > |Y| + |X|, |Y| > |X|을 유지하며 병합(길이가 비슷한 것끼리 합쳐 O(n log n))
+- 병합 전 이진 탐색으로 이미 제자리인 A 앞부분, B 뒷부분을 잘라 낸다(정렬된 입력은 비교 몇 번에 끝남).
+  원본 timsort의 galloping 모드는 넣지 않았다
+*/
+#define TIM_MAX_RUNS 85
+
+static int tim_minrun(int n) {
+    int r = 0;
+    while (n >= 64) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+/* a[0..sorted)이 정렬되어 있을 때 a[0..n)까지 이진 삽입 정렬 */
+static void binary_insertion_cmp(int *a, int n, int sorted, uint64_t *cmp) {
+    for (int i = sorted; i < n; ++i) {
+        int key = a[i];
+        int lo = 0, hi = i;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (LESS(key, a[mid])) hi = mid;
+            else lo = mid + 1;
+        }
+        memmove(a + lo + 1, a + lo, sizeof(int) * (i - lo));
+        a[lo] = key;
+    }
+}
+
+/* a에서 시작하는 자연 구간 길이. 엄격한 내림차순이면 뒤집는다(안정성 유지) */
+static int tim_count_run(int *a, int n, uint64_t *cmp) {
+    if (n < 2) return n;
+    int k = 2;
+    if (LESS(a[1], a[0])) {
+        while (k < n && LESS(a[k], a[k - 1])) k++;
+        for (int i = 0, j = k - 1; i < j; ++i, --j) swap_int(a, i, j);
+    } else {
+        while (k < n && !LESS(a[k], a[k - 1])) k++;
+    }
+    return k;
+}
+
+/* a[0..la)와 a[la..la+lb) 병합. tmp는 la개 이상 */
+static void tim_merge(int *a, int la, int lb, int *tmp, uint64_t *cmp) {
+    int *b = a + la;
+    /* A 중 b[0]보다 크지 않은 앞부분은 제자리 */
+    int lo = 0, hi = la;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (LESS(b[0], a[mid])) hi = mid;
+        else lo = mid + 1;
+    }
+    a += lo;
+    la -= lo;
+    if (la == 0) return;
+    /* B 중 A의 마지막보다 작지 않은 뒷부분은 제자리 */
+    lo = 0;
+    hi = lb;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (LESS(b[mid], a[la - 1])) lo = mid + 1;
+        else hi = mid;
+    }
+    lb = lo;
+    if (lb == 0) return;
+
+    memcpy(tmp, a, sizeof(int) * la);
+    int i = 0, j = 0, o = 0;
+    while (i < la && j < lb) {
+        if (LESS(b[j], tmp[i])) a[o++] = b[j++];
+        else a[o++] = tmp[i++];
+    }
+    while (i < la) a[o++] = tmp[i++];
+}
+
+static uint64_t timsort_count(int *a, int n, int *tmp) {
+    uint64_t c = 0, *cmp = &c;
+    int base[TIM_MAX_RUNS], len[TIM_MAX_RUNS], sp = 0;
+    int minrun = tim_minrun(n);
+    for (int i = 0; i < n; ) {
+        int run = tim_count_run(a + i, n - i, cmp);
+        if (run < minrun) {
+            int force = n - i < minrun ? n - i : minrun;
+            binary_insertion_cmp(a + i, force, run, cmp);
+            run = force;
+        }
+        base[sp] = i;
+        len[sp] = run;
+        sp++;
+        i += run;
+
+        /* 불변식이 깨진 동안 병합 */
+        while (sp > 1) {
+            int k = sp - 2;
+            if ((k > 0 && len[k - 1] <= len[k] + len[k + 1]) || (k > 1 && len[k - 2] <= len[k - 1] + len[k])) {
+                if (len[k - 1] < len[k + 1]) k--;
+            } else if (len[k] > len[k + 1]) {
+                break;
+            }
+            tim_merge(a + base[k], len[k], len[k + 1], tmp, cmp);
+            len[k] += len[k + 1];
+            for (int s = k + 1; s < sp - 1; ++s) {
+                base[s] = base[s + 1];
+                len[s] = len[s + 1];
+            }
+            sp--;
+        }
+    }
+    while (sp > 1) {
+        int k = sp - 2;
+        if (k > 0 && len[k - 1] < len[k + 1]) k--;
+        tim_merge(a + base[k], len[k], len[k + 1], tmp, cmp);
+        len[k] += len[k + 1];
+        for (int s = k + 1; s < sp - 1; ++s) {
+            base[s] = base[s + 1];
+            len[s] = len[s + 1];
+        }
+        sp--;
+    }
+    return c;
+}
+
+#undef LESS
+
+static uint64_t qsort_cmp_count;
+
+static int cmp_int_counted(const void *x, const void *y) {
+    qsort_cmp_count++;
+    return cmp_int(x, y);
+}
+
+/* hw08 dist [n] [reps]: 분포별로 정렬 방식마다 평균 비교 횟수와 시간 */
+#define DIST_SORTS 6
+static int run_dist_bench(int n, int reps) {
+    static const char *const names[DIST_SORTS] = {
+        "qsort           ", "쉘 정렬(간격 표)", "pdqsort         ", "timsort 계열    ",
+        "AVX2 정렬       ", "LSD 기수 정렬   ",
+    };
+    SortBufs b;
+    if (!sort_bufs_alloc(&b, n)) return 1;
+    int *base = b.base, *ref = b.ref, *work = b.work, *tmp = b.tmp;
+    /* 쉘 정렬은 N에 맞춘 표가 있으면 그것, 아니면 정확한 Tokuda */
+    int gaps[64];
+    int gcount;
+    if (n == N) {
+        gcount = TUNED_GAP_COUNT;
+        memcpy(gaps, tuned_gaps, sizeof(tuned_gaps));
+    } else {
+        gcount = build_tokuda_exact_gaps(n, gaps, 64);
+    }
+
+    int bad = 0;
+    printf("데이터 크기: %d, 반복: %d (비교 횟수 / 평균 시간)\n", n, reps);
+    for (int d = 0; d < DIST_COUNT; ++d) {
+        uint64_t cmp[DIST_SORTS] = { 0 };
+        double sec[DIST_SORTS] = { 0 };
+        uint64_t state = 88172645463325252ULL ^ (uint64_t)(d + 1);
+        for (int r = 0; r < reps; ++r) {
+            fill_dist(base, n, d, &state);
+            for (int s = 0; s < DIST_SORTS; ++s) {
+                int *out = s == 0 ? ref : work;     /* qsort 결과가 대조 기준 */
+                clone_array(base, out, n);
+                double t0 = now_sec();
+                switch (s) {
+                case 0:
+                    qsort_cmp_count = 0;
+                    qsort(out, (size_t)n, sizeof(int), cmp_int_counted);
+                    cmp[s] += qsort_cmp_count;
+                    break;
+                case 1: cmp[s] += shell_sort_gaps_count(out, n, gaps, gcount); break;
+                case 2: cmp[s] += pdqsort_count(out, n); break;
+                case 3: cmp[s] += timsort_count(out, n, tmp); break;
+                case 4: vsort_int(out, n); break;
+                default: radix_sort_lsd(out, tmp, n); break;
+                }
+                sec[s] += now_sec() - t0;
+                if (s > 0 && memcmp(out, ref, sizeof(int) * (size_t)n) != 0) bad = 1;
+            }
+        }
+        int best = 0, best_cmp = 0;
+        for (int s = 1; s < DIST_SORTS; ++s) {
+            if (sec[s] < sec[best]) best = s;
+            if (s < 4 && cmp[s] < cmp[best_cmp]) best_cmp = s;
+        }
+        printf("[%s]\n", dist_names[d]);
+        for (int s = 0; s < DIST_SORTS; ++s) {
+            if (s < 4) printf("  %s : %12.0f회, %8.3f ms\n", names[s], (double)cmp[s] / reps, sec[s] / reps * 1e3);
+            else printf("  %s : %12s , %8.3f ms\n", names[s], s == 4 ? "(미집계)" : "(비교 없음)", sec[s] / reps * 1e3);
+        }
+        printf("  -> 가장 빠름: %s / 비교 최소: %s\n", names[best], names[best_cmp]);
+    }
+    if (bad) fprintf(stderr, "[ERR] 정렬 결과가 qsort와 다릅니다\n");
+    sort_bufs_free(&b);
+    return bad;
+}
 
-    uint64_t sum_ins = 0;
-    uint64_t sum_shl = 0;
-    uint64_t sum_tok = 0;
+/* 실행 하나: 같은 무작위 배열을 종류별로 정렬해 비교 횟수와 시간을 기록 */
+#define KINDS 5
+static const char *const kind_names[KINDS] = {
+    "삽입 정렬           ",
+    "쉘 정렬(절반 간격)  ",
+    "쉘 정렬(Tokuda 간격)",
+    "쉘 정렬(최적화 간격)",
+    "LSD 기수 정렬       ",
+};
 
-    for (int run = 1; run <= RUNS; ++run) {
-        fill_random(base, N, &seed);
+typedef struct {
+    uint64_t cmp[KINDS];    /* 기수 정렬은 비교를 하지 않으므로 0 */
+    double sec[KINDS];
+    int bad;                /* 결과가 최적화 간격 쉘 정렬과 다르면 1 */
+} TrialResult;
 
-        clone_array(base, a_ins, N);
-        clone_array(base, a_shl, N);
-        clone_array(base, a_tok, N);
+static void run_trial(uint64_t *state, int *base, int *work, int *ref, TrialResult *res) {
+    fill_random(base, N, state);
+    double t0;
 
-        uint64_t c_ins = insertion_sort_count(a_ins, N);
-        uint64_t c_shl = shell_sort_halving_count(a_shl, N);
-        uint64_t c_tok = shell_sort_tokuda_count(a_tok, N);
+    clone_array(base, work, N);
+    t0 = now_sec();
+    res->cmp[0] = insertion_sort_count(work, N);
+    res->sec[0] = now_sec() - t0;
+    clone_array(base, work, N);
+    t0 = now_sec();
+    res->cmp[1] = shell_sort_halving_count(work, N);
+    res->sec[1] = now_sec() - t0;
+    clone_array(base, work, N);
+    t0 = now_sec();
+    res->cmp[2] = shell_sort_tokuda_count(work, N);
+    res->sec[2] = now_sec() - t0;
+    clone_array(base, ref, N);
+    t0 = now_sec();
+    res->cmp[3] = shell_sort_gaps_count(ref, N, tuned_gaps, TUNED_GAP_COUNT);
+    res->sec[3] = now_sec() - t0;
 
-        sum_ins += c_ins;
-        sum_shl += c_shl;
-        sum_tok += c_tok;
+    /* 기수 정렬: base를 보조 버퍼로 씀(원본은 더 필요 없음) */
+    clone_array(base, work, N);
+    t0 = now_sec();
+    radix_sort_lsd(work, base, N);
+    res->sec[4] = now_sec() - t0;
+    res->cmp[4] = 0;
+    res->bad = memcmp(work, ref, sizeof(int) * N) != 0;
+}
 
-        /* 진행 상황(선택): 주석 해제 시 진행률 출력
-        if (run % 10 == 0) {
-            fprintf(stderr, "진행 %d/%d\n", run, RUNS);
+/*
+RUNS회 실행을 스레드에 연속 구간으로 나눈다. 스레드마다 버퍼를 따로 두고,
+구간 첫 실행의 시작 상태를 점프로 구해 이후는 직렬과 똑같이 이어서 뽑는다.
+실행별 결과를 res[run]에 두고 실행 순서대로 더하므로 스레드 수와 무관하게 직렬 실행과 같은 값이 나온다.
+*/
+static int run_trials(uint64_t seed, int threads, TrialResult *res) {
+    int fail = 0;
+#ifdef _OPENMP
+    if (threads > 0) omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+
+    #pragma omp parallel reduction(|:fail)
+    {
+        int tid = 0, nth = 1;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+        nth = omp_get_num_threads();
+#endif
+        int lo = (int)((long long)RUNS * tid / nth);
+        int hi = (int)((long long)RUNS * (tid + 1) / nth);
+        int *base = (int*)malloc(sizeof(int) * N);
+        int *work = (int*)malloc(sizeof(int) * N);
+        int *ref = (int*)malloc(sizeof(int) * N);
+        if (!base || !work || !ref) {
+            fail = 1;
+        } else if (lo < hi) {
+            uint64_t state = xorshift64_jump(seed, (uint64_t)lo * N);
+            for (int run = lo; run < hi; ++run) run_trial(&state, base, work, ref, &res[run]);
+        }
+        free(base);
+        free(work);
+        free(ref);
+    }
+    return fail;
+}
+
+/*
+사용법: hw08 [seed] [threads]
+  seed를 주면 같은 seed에서 스레드 수와 관계없이 항상 같은 결과(0이나 생략이면 시간 기반)
+  threads 생략 시 OMP_NUM_THREADS/코어 수
+       hw08 opt [n] [samples] [seed] [threads]
+  크기 n(기본 N) 무작위 배열에 맞춘 간격 수열 탐색(기본 표본 100개, seed 1)
+       hw08 radix [n] [reps] [threads]
+  큰 배열(기본 100만)에서 qsort / 쉘 정렬 / LSD 기수 정렬(직렬, 병렬) 시간 비교
+       hw08 vsort [n] [reps]
+  AVX2 정렬 처리량(원소/초)을 qsort, 기수 정렬과 비교(기본 100만)
+       hw08 fuzz [iters] [seed]
+  AVX2 정렬을 여러 크기/분포에서 쉘 정렬, 기수 정렬과 대조(기본 2000회)
+       hw08 dist [n] [reps]
+  입력 분포(균등/정렬/거의 정렬/역순/톱니/값 몇 종)별 정렬 방식 비교 횟수와 시간(기본 N, 20회)
+*/
+int main(int argc, char **argv) {
+    if (argc > 1 && strcmp(argv[1], "dist") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : N;
+        int reps = argc > 3 ? atoi(argv[3]) : 20;
+        if (n < 1 || reps < 1) {
+            fprintf(stderr, "사용법: %s dist [n>=1] [reps>=1]\n", argv[0]);
+            return 1;
+        }
+        return run_dist_bench(n, reps);
+    }
+    if (argc > 1 && strcmp(argv[1], "vsort") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 1000000;
+        int reps = argc > 3 ? atoi(argv[3]) : 5;
+        if (n < 1 || reps < 1) {
+            fprintf(stderr, "사용법: %s vsort [n>=1] [reps>=1]\n", argv[0]);
+            return 1;
+        }
+        return run_vsort_bench(n, reps);
+    }
+    if (argc > 1 && strcmp(argv[1], "fuzz") == 0) {
+        int iters = argc > 2 ? atoi(argv[2]) : 2000;
+        return run_vsort_fuzz(iters > 0 ? iters : 2000, argc > 3 ? strtoull(argv[3], NULL, 10) : 1);
+    }
+    if (argc > 1 && strcmp(argv[1], "radix") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 1000000;
+        int reps = argc > 3 ? atoi(argv[3]) : 5;
+        if (n < 1 || reps < 1) {
+            fprintf(stderr, "사용법: %s radix [n>=1] [reps>=1] [threads]\n", argv[0]);
+            return 1;
+        }
+        return run_radix_bench(n, reps, argc > 4 ? atoi(argv[4]) : 0);
+    }
+    if (argc > 1 && strcmp(argv[1], "opt") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : N;
+        int samples = argc > 3 ? atoi(argv[3]) : RUNS;
+        uint64_t oseed = argc > 4 ? strtoull(argv[4], NULL, 10) : 1;
+        if (n < 2 || samples < 1 || oseed == 0) {
+            fprintf(stderr, "사용법: %s opt [n>=2] [samples>=1] [seed!=0] [threads]\n", argv[0]);
+            return 1;
         }
-        */
+        return run_optimizer(n, samples, oseed, argc > 5 ? atoi(argv[5]) : 0);
     }
 
-    /* 평균 계산 */
-    double avg_ins = (double)sum_ins / RUNS;
-    double avg_shl = (double)sum_shl / RUNS;
-    double avg_tok = (double)sum_tok / RUNS;
+    uint64_t seed = argc > 1 ? strtoull(argv[1], NULL, 10) : 0;
+    int threads = argc > 2 ? atoi(argv[2]) : 0;
+    if (seed == 0) {
+        /* 난수 초기화: 시간 기반 + 주소 혼합으로 시드 강화 */
+        seed = (uint64_t)time(NULL);
+        seed ^= (uint64_t)(uintptr_t)&seed;
+    }
+    if (seed == 0) seed = 88172645463325252ULL;    /* xorshift 상태는 0이면 안 됨 */
 
-    printf("데이터 크기: %d, 실행 횟수: %d\n", N, RUNS);
-    printf("삽입 정렬 평균 비교 횟수            : %.0f\n", avg_ins);
-    printf("쉘 정렬(절반 간격) 평균 비교 횟수    : %.0f\n", avg_shl);
-    printf("쉘 정렬(Tokuda 간격) 평균 비교 횟수  : %.0f\n", avg_tok);
+    TrialResult *res = (TrialResult*)calloc(RUNS, sizeof(TrialResult));
+    if (!res) {
+        fprintf(stderr, "메모리 할당 실패\n");
+        return 1;
+    }
+
+    double t0 = now_sec();
+    if (run_trials(seed, threads, res)) {
+        fprintf(stderr, "메모리 할당 실패\n");
+        free(res);
+        return 1;
+    }
+    double elapsed = now_sec() - t0;
+
+    /* 평균 계산(실행 순서대로 합산) */
+    double avg[KINDS], avg_ms[KINDS];
+    int bad = 0;
+    for (int k = 0; k < KINDS; ++k) {
+        uint64_t sum = 0;
+        double sec = 0.0;
+        for (int run = 0; run < RUNS; ++run) {
+            sum += res[run].cmp[k];
+            sec += res[run].sec[k];
+        }
+        avg[k] = (double)sum / RUNS;
+        avg_ms[k] = sec / RUNS * 1e3;
+    }
+    for (int run = 0; run < RUNS; ++run) bad |= res[run].bad;
+    double avg_ins = avg[0], avg_shl = avg[1], avg_tok = avg[2], avg_opt = avg[3];
+
+    int used = 1;
+#ifdef _OPENMP
+    used = threads > 0 ? threads : omp_get_max_threads();
+#endif
+    printf("데이터 크기: %d, 실행 횟수: %d, seed: %llu, 스레드: %d, 시간: %.3f초\n",
+           N, RUNS, (unsigned long long)seed, used, elapsed);
+    for (int k = 0; k < KINDS; ++k) {
+        if (avg[k] > 0.0) printf("%s 평균 비교 횟수 : %10.0f, 평균 시간: %8.3f ms\n", kind_names[k], avg[k], avg_ms[k]);
+        else printf("%s 평균 비교 횟수 :   (비교 없음), 평균 시간: %8.3f ms\n", kind_names[k], avg_ms[k]);
+    }
 
     /* 상대 개선율 */
     if (avg_shl > 0.0) {
@@ -197,7 +1627,14 @@ int main(void) {
     if (avg_ins > 0.0) {
         printf("Tokuda 대비 삽입 정렬 개선율: %.2f%%\n", (1.0 - avg_tok / avg_ins) * 100.0);
     }
+    if (avg_tok > 0.0) {
+        printf("최적화 간격의 Tokuda 대비 개선율: %.2f%%\n", (1.0 - avg_opt / avg_tok) * 100.0);
+    }
+    if (avg_ms[4] > 0.0) {
+        printf("기수 정렬 속도: 최적화 간격 쉘 정렬 대비 x%.1f\n", avg_ms[3] / avg_ms[4]);
+    }
+    if (bad) fprintf(stderr, "[ERR] 기수 정렬 결과가 쉘 정렬과 다릅니다\n");
 
-    free(base); free(a_ins); free(a_shl); free(a_tok);
-    return 0;
-}
\ No newline at end of file
+    free(res);
+    return bad;
+}